@@ -0,0 +1,262 @@
+"""
+# Measure the planning and scheduling overhead of constructions using synthetic products.
+
+# Generates dependency graphs of (id)`projects` × (id)`factors` nodes each requiring
+# (id)`fanout` nodes of earlier projects, and work directories of (id)`sources` per
+# factor. The times of &..graph.sequence, &..cc.updated, and &..cc.Construction.collect
+# are reported along with the full cold and no-op builds of an existing product
+# when a construction context and product directory are given.
+
+# [ Usage ]
+# (system/command)`python3 -m <package>.bin.benchmark projects factors fanout sources [context product]`
+
+# Full builds are performed with (id)`FPI_EXECUTOR` set to a stub that creates the
+# absent output files named by its arguments and exits immediately so that only the
+# Python-side overhead is measured. The product is copied into a temporary directory
+# and the cold build is forced with (id)`FPI_REBUILD`; the given product is not modified.
+"""
+import os
+import sys
+import time
+import random
+import shutil
+import contextlib
+import subprocess
+import collections
+
+from .. import core
+from .. import cc
+from .. import graph
+from .. import cache
+
+from fault.system import process
+from fault.system import files
+from fault.project import system as lsf
+from fault.time import sysclock
+
+Node = collections.namedtuple('Node', ('name', 'type'))
+Format = collections.namedtuple('Format', ('language', 'dialect'))
+SourceType = collections.namedtuple('SourceType', ('format', 'isolation'))
+
+# Executor used by full builds; creates the outputs that do not exist.
+stub = """#!{python}
+import os, sys
+roots = tuple(os.environ['FPI_BENCHMARK_OUTPUTS'].split(':'))
+for arg in sys.argv[1:]:
+	path = arg.split('=', 1)[-1]
+	if path.startswith(roots) and not os.path.exists(path):
+		try:
+			os.makedirs(os.path.dirname(path), exist_ok=True)
+			open(path, 'ab').close()
+		except OSError:
+			pass
+"""
+
+def synthesize(projects, factors, fanout, seed=0):
+	"""
+	# Construct the nodes and requirements of a synthetic product.
+
+	# Each factor requires &fanout factors selected from the preceding projects.
+	"""
+	r = random.Random(seed)
+	nodes = []
+	edges = {}
+
+	for p in range(projects):
+		layer = [Node(f"p{p}.f{f}", 'library') for f in range(factors)]
+		if nodes:
+			for n in layer:
+				edges[n] = r.sample(nodes, min(fanout, len(nodes)))
+		nodes.extend(layer)
+
+	return nodes, (lambda x: edges.get(x, ()))
+
+@contextlib.contextmanager
+def measure(results, name):
+	start = time.perf_counter()
+	yield
+	results.append((name, time.perf_counter() - start))
+
+def bench_sequence(results, nodes, directory):
+	seq = graph.sequence(directory, nodes)
+
+	with measure(results, 'graph.sequence'):
+		next(seq)
+		completed = None
+		try:
+			while True:
+				work = seq.send(completed)
+				completed = work[0]
+		except StopIteration:
+			pass
+
+def bench_updated(results, route, count):
+	srcs = route/'sources'
+	units = route/'units'
+	pairs = []
+	for i in range(count):
+		s = srcs/f"s{i}.c"
+		u = units/f"s{i}.o"
+		s.fs_alloc().fs_store(b'')
+		u.fs_alloc().fs_store(b'')
+		pairs.append((u, s))
+
+	with measure(results, 'cc.updated'):
+		for u, s in pairs:
+			cc.updated((u,), (s,))
+
+	status = cache.Status()
+	with measure(results, 'cc.updated (status memo)'):
+		for u, s in pairs:
+			cc.updated((u,), (s,), status=status)
+
+class Project(object):
+	"""
+	# Project stub locating factor images in the benchmark's directory.
+	"""
+
+	def __init__(self, route, name):
+		self.route = route
+		self.factor = lsf.types.factor@name
+		self.identifier = 'http://benchmark.example/' + name
+
+	def image(self, variants, fp):
+		return self.route/'images'/str(self.factor)/(str(fp) + '.i')
+
+class Mechanism(object):
+	"""
+	# Mechanism stub producing a trivial command for each phase.
+	"""
+
+	def __init__(self, variants):
+		self._variants = variants
+		self._command = ([], '/bin/true', ['true'])
+
+	def variants(self, intentions, form=''):
+		return self._variants
+
+	def unit_name_delta(self, section, variants, itype):
+		return ('', '.o')
+
+	def _constructor(self, *queries):
+		def construct(q):
+			yield 'operation'
+			yield '-'
+			yield '-'
+			for x in queries:
+				yield from q(x)
+		return construct
+
+	def translate(self, section, variants, itype, srctype):
+		return self._command, self._constructor('source', 'unit')
+
+	def render(self, section, variants, itype):
+		return self._command, self._constructor('units')
+
+	def batch_limit(self, section, variants, itype, srctype):
+		return 0
+
+	def preparation(self, section, variants, itype, srctype):
+		return None
+
+class Log(object):
+	# Transcript stub.
+	def __getattr__(self, name):
+		return (lambda *args, **kw: None)
+
+def construction(cdi, project, targets):
+	return cc.Construction(
+		None, sysclock.elapsed(), Log(),
+		['optimal'], '',
+		cdi, None, {}, None, [],
+		project, targets,
+	)
+
+def bench_collect(results, route, factors, sources):
+	cdi = cache.Transient(route/'cache')
+	project = Project(route, 'bench')
+	itype = lsf.types.Reference(
+		'http://if.fault.io/factors',
+		lsf.types.factor@'system.library', 'type', None
+	)
+	fmt = SourceType(Format('c', None), 'c')
+	variants = [('section', lsf.types.Variants('system', 'architecture', 'optimal', ''))]
+	mechanism = Mechanism(variants)
+
+	targets = []
+	for f in range(factors):
+		srcdir = route/'src'/f"f{f}"
+		srcs = []
+		for s in range(sources):
+			(srcdir/f"s{s}.c").fs_alloc().fs_store(b'')
+			srcs.append((fmt, files.Path(srcdir, (f"s{s}.c",))))
+		targets.append(core.Target(project, lsf.types.factor@f"f{f}", itype, {}, srcs))
+
+	def collect(name):
+		cxn = construction(cdi, project, targets)
+		cxn._filter = cc.updated
+		with measure(results, name):
+			for t in targets:
+				cxn.collect(mechanism, t, {})
+		return cxn
+
+	cxn = collect('Construction.collect (cold)')
+
+	# Materialize the outputs so that the following collection is a no-op.
+	time.sleep(0.01)
+	for tracks in cxn.tracking.values():
+		for phase, instructions, condition in tracks:
+			for ins in instructions:
+				ins[1].fs_alloc().fs_store(b'')
+
+	collect('Construction.collect (no-op)')
+
+def bench_build(results, route, context, product):
+	executor = route/'executor'
+	executor.fs_store(stub.format(python=sys.executable).encode('utf-8'))
+	os.chmod(str(executor), 0o755)
+
+	# Images are written into the product; build a copy.
+	copy = route/'product'
+	shutil.copytree(str(product), str(copy), symlinks=True)
+
+	cdi = route/'build-cache'
+	env = dict(os.environ)
+	env['FPI_EXECUTOR'] = str(executor)
+	env['FPI_BENCHMARK_OUTPUTS'] = ':'.join((str(cdi), str(copy)))
+
+	command = [
+		sys.executable, '-m', __package__ + '.construct',
+		str(context), 'transient', str(cdi), 'optimal', str(copy), '*',
+	]
+
+	for name, rebuild in (('build (cold)', '1'), ('build (no-op)', '0')):
+		env['FPI_REBUILD'] = rebuild
+		with measure(results, name):
+			subprocess.run(command, env=env, stdout=subprocess.DEVNULL, check=False)
+
+def main(inv:process.Invocation) -> process.Exit:
+	projects, factors, fanout, sources, *build = inv.argv
+	projects, factors, fanout, sources = map(int, (projects, factors, fanout, sources))
+
+	results = []
+	nodes, directory = synthesize(projects, factors, fanout)
+
+	with files.Path.fs_tmpdir() as route:
+		bench_sequence(results, nodes, directory)
+		bench_updated(results, route/'updated', factors * sources)
+		bench_collect(results, route/'collect', factors, sources)
+
+		if build:
+			context, product = map(files.Path.from_path, build)
+			bench_build(results, route, context, product)
+
+	print(f"{projects} projects, {factors} factors, {fanout} fan-out, {sources} sources")
+	for name, seconds in results:
+		print(f"{name:36} {seconds * 1000:10.3f}ms")
+
+	inv.exit(0)
+
+if __name__ == '__main__':
+	sys.dont_write_bytecode = True
+	process.control(main, process.Invocation.system())
@@ -10,6 +10,12 @@ from .. import core
 from .. import options
 from .. import cc
 from .. import cache
+from .. import query
+from .. import trace as tracing
+from .. import history as histories
+from .. import workers as persistent
+from .. import memo
+from .. import watch
 
 from fault.context import tools
 from fault.system import process
@@ -34,6 +40,28 @@ class Application(kcore.Context):
 			product, projects,
 			symbols,
 			rebuild=0,
+			plan=None,
+			digests=False,
+			processors=8,
+			renders=None,
+			pipeline=False,
+			batch=False,
+			store=None,
+			limit=None,
+			cutoff=False,
+			trace=None,
+			memory=None,
+			history=None,
+			verbosity=2,
+			spawn=None,
+			workers=False,
+			remote=None,
+			memos={},
+			watching=False,
+			dirty=None,
+			interval=1.0,
+			unity=None,
+			unity_size=8,
 		):
 		self.cxn_executor = executor
 		self.cxn_intentions = intentions
@@ -44,8 +72,49 @@ class Application(kcore.Context):
 		self.cxn_projects = projects
 		self.cxn_local_symbols = symbols
 		self.cxn_rebuild = rebuild
+		self.cxn_plan = plan
+		self.cxn_digests = digests
+		self.cxn_processors = processors
+		self.cxn_renders = renders
+		self.cxn_memory = memory
+		self.cxn_pipeline = frozenset(core.pipelined) if pipeline else frozenset()
+		self.cxn_batch = batch
+		self.cxn_store = store
+		self.cxn_cache_limit = limit
+		self.cxn_cutoff = cutoff
+		self.cxn_unity = unity # Intentions and factor paths translated in chunks.
+		self.cxn_unity_size = unity_size
+		self.cxn_trace = trace # Destination of the trace-event record.
+		self.cxn_trace_record = tracing.Record() if trace is not None else None
+		self.cxn_history = history # Route of the operation history.
+		self.cxn_history_record = None
+		self.cxn_verbosity = verbosity
+		self.cxn_statuses = None
+		self.cxn_status_interval = interval
+		self.cxn_spawn = spawn
+		if workers:
+			# Completions are delivered by a task of the application.
+			self.cxn_workers = persistent.Pool(cc.environment, wake=self.enqueue)
+		else:
+			self.cxn_workers = None
+		self.cxn_remote = remote
+		self.cxn_memos = memos # Explicit sizes of the memo sites.
+
+		# Resident mode; rebuild when sources change.
+		self.cxn_watching = watching
+		self.cxn_watcher = None
+		# Headers read by the translations; watched along with the sources.
+		self.cxn_prerequisites = set() if watching else None
+		self.cxn_changes = set()
+		self.cxn_mechanisms = {} # Composed mechanisms shared by Constructions.
+		self.cxn_dirty = dirty # Changed paths limiting the factors that are processed.
 		self.cxn_extension_map = None
+		self.cxn_status = cache.Status() # Filesystem status shared by Constructions.
+		self.cxn_references = {} # Interpreted references shared by Constructions.
 		self.cxn_log = transcripts.Log.stdout()
+		if verbosity < 1:
+			# Aggregate the per-factor status reports.
+			self.cxn_statuses = cc.Statuses(self.cxn_log, interval)
 
 	@classmethod
 	def from_command(Class, environ, arguments):
@@ -69,8 +138,80 @@ class Application(kcore.Context):
 			assert cache_type == 'persistent'
 			cdi = cache.Persistent(files.Path.from_path(cache_path)/fpath)
 
-		ctx = cc.open_fs_context(ctxdir).load().configure()
+		# Reuse the compositions of previous runs when the context is unchanged.
+		ctx = cc.open_fs_context(ctxdir, compiled=cdi.annotation('vectors'))
+		plan = cdi.annotation('plan')
+		if not ctx.restore(plan):
+			ctx.load().configure()
 		rebuild = int((environ.get('FPI_REBUILD') or '0').strip())
+		digests = bool(int((environ.get('FPI_DIGESTS') or '0').strip()))
+
+		# Process limits; defaults to an overcommit of the available processors.
+		processors = int((environ.get('FPI_PROCESSORS') or '0').strip()) or query.processors()
+		renders = int((environ.get('FPI_RENDERS') or '0').strip()) or None
+		memory = (environ.get('FPI_MEMORY') or '').strip()
+		memory = cache.budget(memory) if memory else None
+		pipeline = bool(int((environ.get('FPI_PIPELINE') or '0').strip()))
+		batch = bool(int((environ.get('FPI_BATCH') or '0').strip()))
+
+		# Shared artifact store; directory path or HTTP URL.
+		store = (environ.get('FPI_STORE') or '').strip()
+		store = cache.store(store) if store else None
+
+		# Size budget for the cache directory; enforced after the build.
+		limit = (environ.get('FPI_CACHE_LIMIT') or '').strip()
+		limit = cache.budget(limit) if limit else None
+		cutoff = bool(int((environ.get('FPI_CUTOFF') or '0').strip()))
+
+		# Amalgamated translation; comma separated intentions and factor paths.
+		unity = (environ.get('FPI_UNITY') or '').strip()
+		unity = frozenset(x.strip() for x in unity.split(',') if x.strip()) or None
+		unity_size = int((environ.get('FPI_UNITY_SIZE') or '8').strip())
+
+		# Transcript detail and process launch method.
+		verbosity = int((environ.get('FPI_VERBOSITY') or '2').strip())
+		interval = float((environ.get('FPI_STATUS_INTERVAL') or '1').strip())
+		spawn = (environ.get('FPI_SPAWN') or '').strip()
+		if spawn == 'posix':
+			spawn = cc.spawn
+		else:
+			spawn = None
+
+		workers = bool(int((environ.get('FPI_WORKERS') or '0').strip()))
+		memos = memo.parse(environ.get('FPI_MEMO') or '')
+		watching = bool(int((environ.get('FPI_WATCH') or '0').strip()))
+
+		# File listing the paths changed since the previous build.
+		dirty = (environ.get('FPI_DIRTY') or '').strip()
+		if dirty:
+			with open(dirty) as f:
+				dirty = set(os.path.abspath(x) for x in f.read().split('\n') if x)
+		else:
+			dirty = None
+
+		# Remote execution; the process limit becomes the size of the remote pool.
+		remote = (environ.get('FPI_DISPATCH') or '').strip()
+		if remote:
+			remote = files.Path.from_path(remote)
+			slots = int((environ.get('FPI_DISPATCH_SLOTS') or '0').strip())
+			processors = slots or processors
+		else:
+			remote = None
+
+		# Durations and memory usage of previous builds.
+		if bool(int((environ.get('FPI_HISTORY') or '0').strip())):
+			history = cdi.annotation('history')
+		else:
+			history = None
+
+		# Trace-event output; stored beside the cache unless a path is given.
+		trace = (environ.get('FPI_TRACE') or '').strip()
+		if trace in {'', '0'}:
+			trace = None
+		elif trace == '1':
+			trace = cdi.annotation('trace.json')
+		else:
+			trace = files.Path.from_path(trace)
 
 		pd = lsf.Product(work)
 		pd.load() #* .product/* files
@@ -83,34 +224,299 @@ class Application(kcore.Context):
 			executor, ctx, cdi,
 			intentions, form,
 			pd, list(projects),
-			symbols, rebuild=rebuild
+			symbols, rebuild=rebuild,
+			plan=plan,
+			digests=digests,
+			processors=processors,
+			renders=renders,
+			pipeline=pipeline,
+			batch=batch,
+			store=store,
+			limit=limit,
+			cutoff=cutoff,
+			trace=trace,
+			memory=memory,
+			history=history,
+			verbosity=verbosity,
+			spawn=spawn,
+			workers=workers,
+			remote=remote,
+			memos=memos,
+			watching=watching,
+			dirty=dirty,
+			interval=interval,
+			unity=unity,
+			unity_size=unity_size,
 		)
 
+	def cxn_dispatch(self):
+		"""
+		# Dispatch the pending Constructions whose required projects have completed.
+		"""
+		incomplete = set(self.cxn_pending)
+		incomplete.update(self.cxn_running)
+
+		for cxn in list(self.cxn_pending):
+			if self.cxn_requirements[cxn] & incomplete:
+				continue
+
+			self.cxn_pending.remove(cxn)
+			self.cxn_running.add(cxn)
+			self.xact_dispatch(kcore.Transaction.create(cxn))
+
+		if self.cxn_pending and not self.cxn_running:
+			# Cycle in the project requirements; proceed in the given order.
+			cxn = self.cxn_pending.pop(0)
+			self.cxn_running.add(cxn)
+			self.xact_dispatch(kcore.Transaction.create(cxn))
+
+	def xact_exit(self, xact):
+		"""
+		# Construction completed; dispatch any dependent projects.
+		"""
+		self.cxn_running.discard(xact.xact_context)
+		self.cxn_dispatch()
+
 	def xact_void(self, final):
 		"""
 		# Called atexit in order to dispatch the next.
 		"""
 
-		try:
-			nj = next(self.cxn_state)
-			self.xact_dispatch(kcore.Transaction.create(nj))
-		except StopIteration:
+		self.cxn_dispatch()
+		if not self.cxn_running:
+			self.cxn_conclude()
+
+			if self.cxn_watching:
+				self.cxn_watch()
+				return
+
+			if self.cxn_workers is not None:
+				self.cxn_workers.terminate()
+
 			# Success unless a crash occurs.
 			self.cxn_log.flush()
 			self.executable.exe_invocation.exit(0)
 
+	def cxn_conclude(self):
+		"""
+		# Store the state retained across builds and report the memo counters.
+		"""
+		if self.cxn_statuses is not None:
+			self.cxn_statuses.flush()
+
+		if self.cxn_plan is not None:
+			self.cxn_context.store(self.cxn_plan)
+
+		if self.cxn_store is not None:
+			self.cxn_store.flush()
+			if not self.cxn_store.available:
+				self.cxn_log.xact_status('<store>',
+					"artifact store could not be reached and was not used", {}
+				)
+
+		if self.cxn_history_record is not None:
+			self.cxn_history_record.store(self.cxn_history)
+
+		if self.cxn_trace is not None:
+			self.cxn_trace_record.store(self.cxn_trace)
+
+		if self.cxn_cache_limit is not None:
+			n, size = self.cxn_cache.collect(self.cxn_cache_limit)
+			if n:
+				self.cxn_log.xact_status('<cache>',
+					f"{n} entries removed releasing {size} bytes", {}
+				)
+
+		for name, hits, misses, evictions, items in memo.report():
+			self.cxn_log.xact_status('<memo>',
+				f"{name}: {hits} hits, {misses} misses, {evictions} evictions, {items} retained", {}
+			)
+
+	def cxn_watch(self):
+		"""
+		# Wait for changes to the sources of the selected projects and
+		# the headers listed by the dependency files of their units.
+		"""
+		paths = set(
+			str(src)
+			for project, targets in self.cxn_targets.values()
+			for t in targets
+			for fmt, src in t.sources()
+		)
+		paths.update(self.cxn_prerequisites)
+
+		if self.cxn_watcher is None:
+			self.cxn_watcher = watch.watcher(paths)
+			watch.monitor(self.cxn_watcher, self.cxn_notify)
+		else:
+			# Sources added since the last build and newly recorded headers.
+			self.cxn_watcher.update(paths)
+
+		if self.cxn_changes:
+			# Changes occurred during the build.
+			self.cxn_changed()
+		else:
+			self.cxn_log.xact_status('<watch>', "waiting for changes", {})
+			self.cxn_log.flush()
+
+	def cxn_notify(self, paths):
+		# Called from the watcher's thread.
+		self.enqueue(tools.partial(self.cxn_changed, paths))
+
+	def cxn_changed(self, paths=()):
+		"""
+		# Rebuild after changes to &paths unless a build is in progress.
+		"""
+		self.cxn_changes.update(paths)
+		if self.cxn_running or self.cxn_pending:
+			return
+
+		changes = self.cxn_changes
+		self.cxn_changes = set()
+		for x in changes:
+			self.cxn_status.invalidate(files.Path.from_absolute(x))
+
+		self.cxn_log.xact_status('<watch>', f"{len(changes)} files changed", {})
+		self.cxn_select()
+		self.cxn_schedule(changes)
+
+	def cxn_affected(self, paths):
+		"""
+		# Identify the targets having sources in &paths.
+
+		# &None when any of the &paths is not a source of a target, such as a
+		# header, as the affected factors cannot be identified.
+		"""
+		affected = set()
+		remainder = set(paths)
+		for project, targets in self.cxn_targets.values():
+			for t in targets:
+				sources = set(str(src) for fmt, src in t.sources())
+				if not sources.isdisjoint(paths):
+					affected.add(t)
+					remainder.difference_update(sources)
+
+		if remainder:
+			return None
+		return affected
+
+	def cxn_schedule(self, changes=None):
+		"""
+		# Create and dispatch the Constructions of the selected projects.
+
+		# When &changes is not &None, only the factors with changed sources
+		# and their dependents are processed.
+		"""
+		self._etime = sysclock.elapsed()
+		pctx, rctx = self.cxn_project_contexts
+		dirty = self.cxn_affected(changes) if changes is not None else None
+
+		seq = self.cxn_sequence = []
+		identifiers = {}
+		for pj_id, (project, targets) in self.cxn_targets.items():
+			identifiers[pj_id] = cc.Construction(
+				self.cxn_executor,
+				self._etime,
+				self.cxn_log,
+				self.cxn_intentions,
+				self.cxn_form,
+				self.cxn_cache,
+				self.cxn_context,
+				self.cxn_symbols,
+				pctx,
+				[pctx, rctx],
+				project,
+				targets,
+				reconstruct=self.cxn_rebuild,
+				digests=self.cxn_digests,
+				status=self.cxn_status,
+				pool=self.cxn_pool,
+				pipeline=self.cxn_pipeline,
+				references=self.cxn_references,
+				batch=self.cxn_batch,
+				store=self.cxn_store,
+				cutoff=self.cxn_cutoff,
+				trace=self.cxn_trace_record,
+				history=self.cxn_history_record,
+				verbosity=self.cxn_verbosity,
+				spawn=self.cxn_spawn,
+				workers=self.cxn_workers,
+				remote=self.cxn_remote,
+				mechanisms=self.cxn_mechanisms,
+				dirty=dirty,
+				statuses=self.cxn_statuses,
+				unity=self.cxn_unity,
+				unity_size=self.cxn_unity_size,
+				prerequisites=self.cxn_prerequisites,
+			)
+			seq.append(identifiers[pj_id])
+
+		# Order the Constructions by their project requirements; projects
+		# outside of the selection are presumed to be complete.
+		self.cxn_requirements = {
+			identifiers[pj_id]: set(
+				identifiers[x] for x in refs
+				if x in identifiers and x != pj_id
+			)
+			for pj_id, refs in self.cxn_project_references.items()
+		}
+
+		self.cxn_pending = list(seq)
+		self.cxn_running = set()
+		self.xact_void(None)
+
+	def cxn_select(self):
+		"""
+		# Identify the targets of the selected projects; returns the number of factors.
+
+		# Performed at startup and before each rebuild in watch mode so that
+		# added sources are included.
+		"""
+		pctx = self.cxn_project_contexts[0]
+		local_symbols = self.cxn_symbols
+
+		self.cxn_targets = {}
+		references = self.cxn_project_references = {}
+		nfactors = 0
+		for project_factor in self.cxn_projects:
+			constraint = lsf.types.factor
+			pj_id = self.cxn_product.identifier_by_factor(project_factor)[0]
+			project = pctx.project(pj_id)
+
+			# Resolve relative references to absolute while maintaining set/sequence.
+			symbols = collections.ChainMap(local_symbols, pctx.symbols(project))
+			targets = [
+				core.Target(
+					project, fp,
+					ft, # integration-type
+					{x: symbols[x] for x in fs[0]}, # requirements
+					fs[1], # sources
+					variants={'name':fp.identifier})
+				for (fp, ft), fs in project.select(constraint)
+			]
+			nfactors += len(targets)
+			self.cxn_targets[pj_id] = (project, targets)
+
+			# Projects referred to by the targets.
+			references[pj_id] = set(
+				cc.reference_project(r)
+				for t in targets
+				for refs in t.symbols.values()
+				for r in refs
+				if not isinstance(r, (core.Target, core.SystemFactor))
+			)
+
+		return nfactors
+
 	def actuate(self):
 		"""
 		# Prepare the entire package building factor targets and writing bytecode.
 		"""
 
-		self._etime = sysclock.elapsed()
 		self.cxn_log.declare()
 		self.cxn_log.flush()
 
 		work = self.cxn_work_directory
-		re = self.cxn_rebuild
-		ctx = self.cxn_context
 
 		# Project Context
 		pctx = lsf.Context()
@@ -118,6 +524,7 @@ class Application(kcore.Context):
 		rctx.load() # Connection Project Index (requirements)
 		pctx.load() # Build Project Index (targets)
 		pctx.configure() # Protocol Configuration Inheritance.
+		self.cxn_project_contexts = (pctx, rctx)
 
 		# Separate options into named slots.
 		local_symbols = {}
@@ -131,50 +538,53 @@ class Application(kcore.Context):
 		# Parse options for each slot.
 		for k in list(local_symbols):
 			local_symbols[k] = list(options.parse(local_symbols[k]))
+		self.cxn_symbols = local_symbols
 
-		seq = self.cxn_sequence = []
-		for project_factor in self.cxn_projects:
-			constraint = lsf.types.factor
-			pj_id = self.cxn_product.identifier_by_factor(project_factor)[0]
-			project = pctx.project(pj_id)
+		# Process slots shared by all the projects' Constructions.
+		plimits = {}
+		if self.cxn_renders is not None:
+			plimits['render'] = self.cxn_renders
+		pool = self.cxn_pool = cc.Processors(self.cxn_processors, plimits, memory=self.cxn_memory)
 
-			# Resolve relative references to absolute while maintaining set/sequence.
-			symbols = collections.ChainMap(local_symbols, pctx.symbols(project))
-			targets = [
-				core.Target(
-					project, fp,
-					ft, # integration-type
-					{x: symbols[x] for x in fs[0]}, # requirements
-					fs[1], # sources
-					variants={'name':fp.identifier})
-				for (fp, ft), fs in project.select(constraint)
-			]
-
-			seq.append(cc.Construction(
-				self.cxn_executor,
-				self._etime,
-				self.cxn_log,
-				self.cxn_intentions,
-				self.cxn_form,
-				self.cxn_cache,
-				self.cxn_context,
-				local_symbols,
-				pctx,
-				[pctx, rctx],
-				project,
-				targets,
-				processors=8, # overcommit significantly
-				reconstruct=re,
-			))
+		if self.cxn_history is not None:
+			self.cxn_history_record = histories.Record.load(self.cxn_history)
+			for factor, phase, memory in self.cxn_history_record.memory():
+				pool.observe(factor, phase, memory)
 
-		self.cxn_state = iter(seq)
-		self.xact_void(None)
+		nfactors = self.cxn_select()
+		memo.configure(nfactors, self.cxn_memos)
+		self.cxn_schedule(self.cxn_dirty)
 
 def main(inv:process.Invocation) -> process.Exit:
 	inv.imports([
 		'FPI_EXECUTOR',
 		'FPI_CACHE',
 		'FPI_REBUILD',
+		'FPI_DIGESTS',
+		'FPI_PROCESSORS',
+		'FPI_RENDERS',
+		'FPI_MEMORY',
+		'FPI_PIPELINE',
+		'FPI_BATCH',
+		'FPI_STORE',
+		'FPI_CACHE_LIMIT',
+		'FPI_CUTOFF',
+		'FPI_UNITY',
+		'FPI_UNITY_SIZE',
+		'FPI_TRACE',
+		'FPI_HISTORY',
+		'FPI_VERBOSITY',
+		'FPI_STATUS_INTERVAL',
+		'FPI_SPAWN',
+		'FPI_WORKERS',
+		'FPI_MEMO',
+		'FPI_WATCH',
+		'FPI_DIRTY',
+		'FPI_DISPATCH',
+		'FPI_DISPATCH_SLOTS',
+		'FPI_DISPATCH_HOSTS',
+		'FPI_DISPATCH_SSH',
+		'FPI_DISPATCH_RSYNC',
 		'FPI_MECHANISMS',
 		'FACTORPATH',
 		'FRAMECHANNEL',
@@ -0,0 +1,92 @@
+"""
+# Execute a command described by a construction manifest on a remote host.
+
+# Used by the (id)`FPI_DISPATCH` command of &.construct, an executable running
+# the module with its arguments; invoked with the path to the manifest written by
+# &..cc.manifest. The declared inputs, including directories, are transferred
+# with rsync to the same absolute paths on the selected host, the command is
+# executed using ssh with the standard I/O of this process relayed, and the declared
+# outputs are retrieved. The hosts are presumed to have the same toolchains and
+# system files installed at the same paths as the local host.
+
+# [ Environment ]
+# /FPI_DISPATCH_HOSTS/
+	# The whitespace or comma separated list of hosts to execute commands on.
+# /FPI_DISPATCH_SSH/
+	# The remote shell command; defaults to (system/command)`ssh`.
+# /FPI_DISPATCH_RSYNC/
+	# The file transfer command; defaults to (system/command)`rsync`.
+"""
+import os
+import sys
+import json
+import shlex
+import zlib
+import subprocess
+
+def select(hosts, key:str) -> str:
+	"""
+	# Choose the host for the manifest identified by &key.
+
+	# Consistent across invocations so that repeated builds of a unit
+	# reuse the files already transferred to the host.
+	"""
+	return hosts[zlib.crc32(key.encode('utf-8')) % len(hosts)]
+
+def transfer(rsync, paths, source, destination) -> int:
+	"""
+	# Copy the absolute &paths from &source to &destination preserving their location.
+	# Directories are copied recursively.
+	"""
+	relative = '\n'.join(x.lstrip('/') for x in paths) + '\n'
+	p = subprocess.run(
+		rsync + ['-a', '-r', '--files-from=-', '--ignore-missing-args', source, destination],
+		input=relative.encode('utf-8'),
+		stdout=subprocess.DEVNULL,
+	)
+	return p.returncode
+
+def remote(manifest) -> str:
+	"""
+	# Construct the shell command executing the manifest's command on the host.
+	"""
+	env = ' '.join(shlex.quote(k + '=' + v) for k, v in manifest['environment'])
+	args = ' '.join(map(shlex.quote, manifest['arguments'][1:]))
+	dirs = {os.path.dirname(x) for x in manifest['outputs']}
+
+	return ' && '.join([
+		'mkdir -p ' + ' '.join(map(shlex.quote, sorted(dirs))),
+		'cd ' + shlex.quote(manifest['directory']),
+		' '.join(x for x in ('exec env', env, shlex.quote(manifest['executable']), args) if x),
+	])
+
+def main(argv, environ):
+	path, = argv[1:]
+	with open(path) as f:
+		manifest = json.load(f)
+
+	hosts = environ.get('FPI_DISPATCH_HOSTS', '').replace(',', ' ').split()
+	if not hosts:
+		sys.stderr.write("dispatch: no hosts configured in FPI_DISPATCH_HOSTS\n")
+		return 254
+
+	ssh = shlex.split(environ.get('FPI_DISPATCH_SSH') or 'ssh')
+	rsync = shlex.split(environ.get('FPI_DISPATCH_RSYNC') or 'rsync')
+	host = select(hosts, path)
+
+	if transfer(rsync, manifest['inputs'], '/', host + ':/') != 0:
+		sys.stderr.write("dispatch: could not transfer inputs to " + host + "\n")
+		return 253
+
+	# Standard I/O is inherited; the construction relays it to the unit's files.
+	status = subprocess.run(ssh + [host, remote(manifest)]).returncode
+
+	if transfer(rsync, manifest['outputs'], host + ':/', '/') != 0:
+		sys.stderr.write("dispatch: could not retrieve outputs from " + host + "\n")
+		if status == 0:
+			return 252
+
+	return status
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv, os.environ))
@@ -1,21 +1,167 @@
 """
 # Interface for construction context build cache.
 """
-from fault.context import tools
+import os
+import shutil
+import typing
+import hashlib
+
 from fault.system import files
 
+from . import stage
+
+class Status(object):
+	"""
+	# Filesystem status memory shared by the &..cc.Construction instances of a run.
+
+	# Status records are retained until &invalidate is used to note that
+	# the file has been written.
+	"""
+	def __init__(self):
+		self.records = {}
+
+	def __call__(self, route:files.Path):
+		"""
+		# Retrieve the status of &route or &None if the file does not exist.
+		"""
+		try:
+			return self.records[route]
+		except KeyError:
+			try:
+				st = route.fs_status()
+			except FileNotFoundError:
+				st = None
+
+			self.records[route] = st
+			return st
+
+	def invalidate(self, route:files.Path):
+		"""
+		# Discard the recorded status of &route.
+		"""
+		self.records.pop(route, None)
+
+def identify(project, factor, key:bytes) -> str:
+	"""
+	# Construct the deterministic identifier of a cache entry.
+
+	# Used by all &Directory classes so that work directories are consistent
+	# across processes and concurrent constructions.
+	"""
+	h = hashlib.blake2b(digest_size=20)
+	for x in (str(project).encode('utf-8'), str(factor).encode('utf-8'), key):
+		# Length prefixed to avoid ambiguous concatenations.
+		h.update(len(x).to_bytes(4, 'big'))
+		h.update(x)
+	return h.hexdigest()
+
+def budget(spec:str) -> int:
+	"""
+	# Interpret a size specification such as (id)`512M` or (id)`20G` as a number of bytes.
+	"""
+	spec = spec.strip().upper()
+	units = {'K': 1 << 10, 'M': 1 << 20, 'G': 1 << 30, 'T': 1 << 40}
+	if spec[-1:] in units:
+		return int(float(spec[:-1]) * units[spec[-1]])
+	return int(spec)
+
+def _usage(path:str) -> int:
+	# Disk usage of a directory tree without following links.
+	total = 0
+	for dirpath, dirs, names in os.walk(path):
+		for x in names:
+			try:
+				total += os.lstat(os.path.join(dirpath, x)).st_size
+			except FileNotFoundError:
+				pass
+	return total
+
 class Directory(object):
 	"""
 	# A filesystem directory managing the build cache of a project set.
+
+	# Entries are positioned by &identify and their modification times
+	# are updated on &select for least recently used eviction by &collect.
 	"""
+
+	# Number of directories between &route and an entry.
+	depth = 3
+
 	def __init__(self, route:files.Path):
 		self.route = route
 
+	@staticmethod
+	def _touch(route:files.Path):
+		# Note the use of the entry for &collect.
+		try:
+			os.utime(str(route))
+		except FileNotFoundError:
+			pass
+		return route
+
 	def select(self, project, factor, key) -> files.Path:
 		"""
 		# Retrieve the route to the work directory for the project's factor.
 		"""
-		return self.route/project/factor/str(hash(key))
+		return self._touch(self.route/str(project)/str(factor)/identify(project, factor, key))
+
+	def annotation(self, name:str) -> files.Path:
+		"""
+		# Retrieve the route to a file holding information about the builds
+		# using the cache; plans, traces, and histories.
+		"""
+		return self.route/'.factors'/name
+
+	def entries(self) -> typing.Sequence[str]:
+		"""
+		# The paths of the entries present in the cache.
+		"""
+		level = [str(self.route)]
+		for i in range(self.depth):
+			subdirs = []
+			for d in level:
+				try:
+					with os.scandir(d) as scan:
+						subdirs.extend(
+							x.path for x in scan
+							if x.name[:1] != '.' and x.is_dir(follow_symlinks=False)
+						)
+				except FileNotFoundError:
+					pass
+			level = subdirs
+
+		return level
+
+	def collect(self, limit:int) -> typing.Tuple[int, int]:
+		"""
+		# Remove the least recently selected entries until the total size
+		# of the cache is within &limit bytes.
+
+		# Returns the number of entries removed and the number of bytes released.
+		"""
+		records = []
+		total = 0
+		for entry in self.entries():
+			try:
+				mtime = os.stat(entry).st_mtime
+			except FileNotFoundError:
+				continue
+			size = _usage(entry)
+			records.append((mtime, size, entry))
+			total += size
+
+		records.sort()
+		removed = released = 0
+		for mtime, size, entry in records:
+			if total <= limit:
+				break
+
+			shutil.rmtree(entry, ignore_errors=True)
+			total -= size
+			removed += 1
+			released += size
+
+		return removed, released
 
 class Persistent(Directory):
 	"""
@@ -24,47 +170,194 @@ class Persistent(Directory):
 	# Uses a hashed-key path directory to store and recall entries.
 	"""
 
-	@tools.cachedproperty
-	def hkp(self):
-		"""
-		# HKP addressing data.
-		"""
-		from fault.hkp import library
-		return library.Hash('fnv1a_64', depth=1, length=4)
-
-	@tools.cachedproperty
-	def index(self):
-		from fault.hkp import library
-		return library.Dictionary.use(self.route, addressing=self.hkp)
+	depth = 2
 
 	def select(self, project, factor, key):
-		prefix = str(project) + '[' + str(factor) + ']:'
-		return self.index.route(prefix.encode('utf-8') + key, filename=str)
+		k = identify(project, factor, key)
+		return self._touch(self.route/k[:2]/k)
 
 class Transient(Directory):
 	"""
 	# Cache directory interface for builds whose cache is expected to be removed.
 
-	# Uses an in memory index to recall positioning and counters to allocate new entries.
+	# Entries are grouped by project.
 	"""
 
-	@tools.cachedproperty
-	def counters(self):
-		import collections
-		import itertools
-		return collections.defaultdict(itertools.count)
-
-	@tools.cachedproperty
-	def index(self):
-		return dict()
+	depth = 2
 
 	def select(self, project, factor, key):
-		project = str(project)
-		factor = str(factor)
+		return self._touch(self.route/str(project)/identify(project, factor, key))
+
+class Store(object):
+	"""
+	# Content addressed artifact store shared by the hosts performing builds.
+
+	# Artifacts are addressed by the digest of their inputs and the command
+	# that produced them; see &..cc.digest. Translations also store their
+	# dependency file under the digest of the source and the command with a
+	# (id)`.d` suffix; the headers it lists complete the key of the unit.
 
-		if (project, factor, key) not in self.index:
-			cid = next(self.counters[project])
-			work = self.route/project/str(cid)
-			self.index[(project, factor, key)] = work
+	# [ Properties ]
+	# /available/
+		# Whether the store is used; cleared by implementations that
+		# could not reach the store.
+	"""
+	available = True
+
+	@staticmethod
+	def _path(key:str):
+		return (key[:2], key)
+
+	def fetch(self, key:str, target:files.Path) -> bool:
+		"""
+		# Write the artifact identified by &key to &target.
+		# Returns &False if the store has no such artifact.
+		"""
+		raise NotImplementedError
+
+	def deposit(self, key:str, source:files.Path) -> bool:
+		"""
+		# Record the artifact at &source under &key.
+		"""
+		raise NotImplementedError
+
+	def fetch_all(self, requests:typing.Sequence[typing.Tuple[str, files.Path]]) -> typing.Set[files.Path]:
+		"""
+		# Perform &fetch for each of the (key, target) pairs of &requests.
+		# Returns the set of targets that were written.
+		"""
+		return set(t for k, t in requests if self.available and self.fetch(k, t))
+
+	def flush(self):
+		"""
+		# Wait for the completion of any deposits performed in the background.
+		"""
+		pass
+
+	@staticmethod
+	def _replace(target:files.Path, write):
+		# Write to a temporary beside &target and rename.
+		target.fs_alloc()
+		tmp = str(target) + '.' + str(os.getpid())
+		try:
+			with open(tmp, 'wb') as f:
+				write(f)
+			os.replace(tmp, str(target))
+		except BaseException:
+			if os.path.exists(tmp):
+				os.unlink(tmp)
+			raise
+
+class DirectoryStore(Store):
+	"""
+	# &Store implementation using a, usually network mounted, directory.
+	"""
+
+	def __init__(self, route:files.Path):
+		self.route = route
+
+	def fetch(self, key, target):
+		entry = files.Path(self.route, self._path(key))
+		try:
+			# Reflinked when the store shares the filesystem; a new file
+			# so that the target is more recent than its inputs.
+			stage.place(entry, target, linked=False)
+		except OSError:
+			return False
+
+		return True
 
-		return self.index[(project, factor, key)]
+	def deposit(self, key, source):
+		entry = files.Path(self.route, self._path(key))
+		if entry.fs_type() != 'void':
+			return True
+		if source.fs_type() != 'data':
+			# Only regular files are stored.
+			return False
+
+		stage.place(source, entry)
+		return True
+
+class HTTPStore(Store):
+	"""
+	# &Store implementation using GET and PUT requests against a URL prefix.
+
+	# Requests are performed by a pool of threads: &fetch_all issues its lookups
+	# concurrently and &deposit returns once the upload is queued. The store is
+	# disabled after the first failure to connect so that an unreachable store
+	# costs one timeout rather than one per unit.
+	"""
+
+	def __init__(self, url:str, timeout:float=10.0, connections:int=8):
+		from concurrent import futures
+
+		self.url = url.rstrip('/')
+		self.timeout = timeout
+		self.available = True
+		self.executor = futures.ThreadPoolExecutor(connections)
+		self.deposits = []
+
+	def _url(self, key):
+		return self.url + '/' + '/'.join(self._path(key))
+
+	def _request(self, req, receive=None) -> bool:
+		import urllib.request
+		import urllib.error
+
+		if not self.available:
+			return False
+
+		try:
+			with urllib.request.urlopen(req, timeout=self.timeout) as r:
+				if receive is not None:
+					receive(r)
+		except urllib.error.HTTPError:
+			# Misses and refused uploads; the store is reachable.
+			return False
+		except (urllib.error.URLError, OSError):
+			self.available = False
+			return False
+
+		return True
+
+	def fetch(self, key, target):
+		return self._request(self._url(key),
+			(lambda r: self._replace(target, (lambda f: shutil.copyfileobj(r, f))))
+		)
+
+	def fetch_all(self, requests):
+		jobs = [(t, self.executor.submit(self.fetch, k, t)) for k, t in requests]
+		return set(t for t, job in jobs if job.result())
+
+	def _put(self, key, source):
+		import urllib.request
+
+		try:
+			data = source.fs_load()
+		except OSError:
+			return False
+
+		req = urllib.request.Request(self._url(key), data=data, method='PUT')
+		return self._request(req)
+
+	def deposit(self, key, source):
+		if not self.available or source.fs_type() != 'data':
+			return False
+
+		self.deposits.append(self.executor.submit(self._put, key, source))
+		return True
+
+	def flush(self):
+		deposits = self.deposits
+		self.deposits = []
+		for job in deposits:
+			job.result()
+
+def store(spec:str) -> Store:
+	"""
+	# Construct the &Store identified by &spec; an HTTP URL or a directory path.
+	"""
+	if spec.startswith('http://') or spec.startswith('https://'):
+		return HTTPStore(spec)
+	else:
+		return DirectoryStore(files.Path.from_path(spec))
@@ -2,11 +2,17 @@
 # Software Construction Context implementation in Python.
 """
 import os
+import re
 import sys
+import json
 import functools
 import collections
 import contextlib
 import typing
+import hashlib
+import heapq
+import itertools
+import time
 
 from fault.context import tools
 from fault.time import sysclock
@@ -21,7 +27,11 @@ from fault.transcript import metrics
 
 from . import graph
 from . import core
+from . import cache as fscache
 from . import vectorcontext
+from . import workers as persistent
+from . import memo
+from . import stage
 
 open_fs_context = vectorcontext.Context.from_directory
 devnull = files.Path.from_absolute(os.devnull)
@@ -34,6 +44,107 @@ def local_query(integrand, local, query):
 		return [r]
 	return list(map(str, integrand.select(query)))
 
+_environments = {}
+def environment(settings) -> typing.Mapping[str, str]:
+	"""
+	# Retrieve the process environment for a command template's &settings.
+
+	# The environment is constructed once per template and shared by all of the
+	# template's invocations; it must not be modified.
+	"""
+	try:
+		key = tuple(settings)
+		return _environments[key]
+	except TypeError:
+		# Unhashable settings; construct an independent instance.
+		key = None
+	except KeyError:
+		pass
+
+	env = dict(os.environ)
+	env.update(settings)
+	if key is not None:
+		_environments[key] = env
+	return env
+
+def spawn(xpath, xargs, environ, fdmap):
+	"""
+	# Launch the process using &os.posix_spawn instead of fork and exec.
+
+	# [ Parameters ]
+	# /xpath/
+		# The absolute path to the executable.
+	# /xargs/
+		# The argument vector including the command name.
+	# /environ/
+		# The complete environment of the process.
+	# /fdmap/
+		# The file descriptors to duplicate into the process.
+	"""
+	dup = os.POSIX_SPAWN_DUP2
+	return os.posix_spawn(str(xpath), xargs, environ,
+		file_actions=[(dup, src, dst) for src, dst in fdmap]
+	)
+
+# Installation locations presumed to be present on remote hosts.
+system_directories = ('/usr/', '/lib/', '/lib64/', '/opt/', '/System/', '/Library/')
+
+def directories(xargs) -> typing.Iterator[str]:
+	"""
+	# The directories named by the arguments of a command, excluding &system_directories.
+
+	# Identifies the include paths of a translation so that remote hosts have the
+	# headers before the dependency file of the unit has been recorded.
+	"""
+	for x in xargs:
+		if x.startswith('-'):
+			# Option with an attached path; (id)`-I/path`.
+			i = x.find('/')
+			if i == -1:
+				continue
+			x = x[i:]
+
+		if x.startswith('/') and not (x + '/').startswith(system_directories):
+			if os.path.isdir(x):
+				yield x
+
+def transferred(paths) -> typing.List[str]:
+	"""
+	# The sorted &paths that are not within &system_directories; the inputs
+	# that remote hosts are given. System headers listed by dependency files
+	# are presumed to be installed on the hosts.
+	"""
+	return sorted(set(
+		x for x in map(str, paths)
+		if not (x + '/').startswith(system_directories)
+	))
+
+def manifest(plan, inputs, outputs) -> bytes:
+	"""
+	# Serialize the instructions for executing a prepared command on a remote host.
+
+	# The dispatch command given the manifest is expected to transfer the &inputs,
+	# execute the command with its standard I/O relayed, and retrieve the &outputs.
+	# See (system/file)`bin/dispatch.py` for an implementation using SSH.
+
+	# [ Parameters ]
+	# /plan/
+		# The environment settings, executable, and argument vector of the command.
+	# /inputs/
+		# The paths of the files and directories read by the command.
+	# /outputs/
+		# The paths of the files written by the command.
+	"""
+	settings, xpath, xargs = plan
+	return json.dumps({
+		'environment': [list(x) for x in settings],
+		'executable': str(xpath),
+		'arguments': list(xargs),
+		'directory': os.getcwd(),
+		'inputs': list(inputs),
+		'outputs': list(outputs),
+	}, indent=1).encode('utf-8')
+
 def prepare(command, args, log, output, input, executor=None):
 	"""
 	# Given a command and its constructed arguments, interpret the
@@ -75,18 +186,21 @@ def prepare(command, args, log, output, input, executor=None):
 
 	xargs = list(command[2])
 	xargs.extend(args)
-	env = dict(os.environ)
-	env.update(command[0])
+	env = environment(command[0])
 
 	xpath = executor or command[1]
 	ki = libexec.KInvocation(xpath, xargs, environ=env)
 	return (opid, output, stdin, stdout, log, (command[0], xpath, xargs), ki)
 
-@tools.cachedcalls(12)
+@memo.cached('factor-types', 32)
 def _ftype(itype):
 	return itype.project + '/' + str(itype.factor ** 1)
 
-@tools.cachedcalls(8)
+@memo.cached('factor-identifiers', 32)
+def _fidentifier(itype):
+	return itype.project + '/' + str(itype.factor)
+
+@memo.cached('work-keys', 32)
 def work_key_cache(prefix, variants):
 	key = prefix
 	# Using slashes as separators as they should not
@@ -112,29 +226,50 @@ def rebuild(outputs, inputs, subfactor=True, cascade=False):
 
 	return False
 
-def updated(outputs, inputs, never=False, cascade=False, subfactor=True):
+def _forced(never, cascade, subfactor):
+	# Whether the rebuild configuration overrides the up-to-date checks.
+	if never:
+		# Never up-to-date.
+		if cascade:
+			# Everything gets refreshed.
+			return True
+		elif subfactor:
+			# Subfactor inherits never regardless of cascade.
+			return True
+
+	return False
+
+def fs_status(route):
+	"""
+	# Retrieve the status of &route or &None if the file does not exist.
+	# Unmemorized default used by &updated and &identical.
+	"""
+	try:
+		return route.fs_status()
+	except FileNotFoundError:
+		return None
+
+def updated(outputs, inputs, never=False, cascade=False, subfactor=True, status=fs_status):
 	"""
 	# Return whether or not the &outputs are up-to-date.
 
 	# &False returns means that the target should be reconstructed,
 	# and &True means that the file is up-to-date and needs no processing.
+
+	# &status is used to retrieve file status; normally a shared &cache.Status
+	# instance when used by &Construction.
 	"""
 
-	if never:
-		# Never up-to-date.
-		if cascade:
-			# Everything gets refreshed.
-			return False
-		elif subfactor:
-			# Subfactor inherits never regardless of cascade.
-			return False
+	if _forced(never, cascade, subfactor):
+		return False
 
 	olm = None
 	for output in outputs:
-		if output.fs_type() == 'void':
+		stat = status(output)
+		if stat is None:
 			# No such object, not updated.
 			return False
-		lm = output.fs_status().system.st_mtime
+		lm = stat.system.st_mtime
 		olm = min(lm, olm or lm)
 
 	# Otherwise, check the inputs against outputs.
@@ -142,9 +277,8 @@ def updated(outputs, inputs, never=False, cascade=False, subfactor=True):
 	# to perform the input checks.
 
 	for x in inputs:
-		try:
-			stat = x.fs_status()
-		except FileNotFoundError:
+		stat = status(x)
+		if stat is None:
 			# This appears undesirable, but the case is that &updated is used
 			# in situation where the &inputs are supposed to exist. If they
 			# do not, it is likely that integration was performed incorrectly.
@@ -160,25 +294,169 @@ def updated(outputs, inputs, never=False, cascade=False, subfactor=True):
 	# object has already been updated.
 	return True
 
-def interpret_reference(cc, ctxpath, _factor, symbol, reference, rreqs={}, rsources=[]):
+def digest(inputs, plan, /, relative=(), algorithm=hashlib.blake2b):
 	"""
-	# Extract the project identifier from the &url and find a corresponding project.
+	# Construct the content digest of the &inputs and the command &plan
+	# that processes them.
 
-	# The fragment portion of the URL specifies the factor within the project
-	# that should be connected in order to use the &symbol.
+	# [ Parameters ]
+	# /inputs/
+		# The &files.Path instances whose content is digested.
+		# Absent files and directories contribute only their path.
+	# /plan/
+		# The `(environment, executable, arguments)` triple of the command
+		# as produced by &prepare.
+	# /relative/
+		# Sequence of `(prefix, marker)` pairs substituted in the paths and
+		# the command so that the digest is consistent across hosts.
+	"""
+	def norm(s):
+		for prefix, marker in relative:
+			s = s.replace(prefix, marker)
+		return s.encode('utf-8')
+
+	env, xpath, xargs = plan
+	h = algorithm(digest_size=32)
+	h.update(norm(''.join(libexec.serialize_sx_plan((list(env), xpath, xargs)))))
+
+	for x in inputs:
+		h.update(b'\x00' + norm(str(x)) + b'\x00')
+		try:
+			h.update(x.fs_load())
+		except (FileNotFoundError, IsADirectoryError):
+			pass
+
+	return h.hexdigest().encode('ascii')
+
+def relocate(text:str, relative, /, restore=False) -> str:
+	"""
+	# Substitute the markers of the `(prefix, marker)` pairs of &relative for
+	# their prefixes in &text; or the prefixes for the markers when &restore is true.
+
+	# Used to store dependency files under host independent paths.
+	"""
+	for prefix, marker in relative:
+		if restore:
+			text = text.replace(marker, prefix)
+		else:
+			text = text.replace(prefix, marker)
+	return text
+
+def weight(history, factor) -> int:
+	"""
+	# The cost of &factor for &graph.sequence according to &history.
+
+	# System factors are never processed and are given a unit cost.
+	"""
+	if isinstance(factor, core.SystemFactor):
+		return 1
+	return history.cost(factor.absolute_path_string)
+
+def _content(route):
+	# Digest of the file's content; &None if absent.
+	try:
+		return hashlib.blake2b(route.fs_load(), digest_size=32).digest()
+	except (FileNotFoundError, IsADirectoryError):
+		return None
+
+def identical(outputs, record, state, never=False, cascade=False, subfactor=True, status=fs_status):
+	"""
+	# Return whether or not the &outputs are up-to-date with respect to the
+	# digest stored in &record.
+
+	# Content based alternative to &updated that disregards modification times.
+	# &state is the &digest of the current inputs and command.
+	"""
+
+	if _forced(never, cascade, subfactor):
+		return False
+
+	for output in outputs:
+		if status(output) is None:
+			return False
+
+	try:
+		return record.fs_load() == state
+	except FileNotFoundError:
+		return False
+
+def reference_project(reference):
+	"""
+	# Identify the project referred to by &reference.
+	# &None if the reference is to a virtual factor.
 	"""
 	if reference.method in {'type', 'control'}:
 		# Virtual factors.
-		return
+		return None
 
 	i = ri.parse(reference.project)
-	fpath = reference.factor
 	rproject_name = i['path'][-1]
 
 	i['path'][-1] = '' # Force the trailing slash in serialize()
 	product = ri.serialize(i)
 
-	id = product + rproject_name
+	return product + rproject_name
+
+def divide(text:str, sources:typing.Sequence[str]) -> typing.Sequence[str]:
+	"""
+	# Divide the diagnostics of a batched translation by the members' &sources.
+
+	# Compilers prefix diagnostics with the (id)`file:line:` location in the source
+	# or, for headers, precede them with the location of the including source.
+	# Lines without a member's location continue the part of the prior member,
+	# and leading lines are given to every member.
+	"""
+	prefixes = [x + ':' for x in sources]
+	leading = []
+	parts = [[] for x in sources]
+	current = leading
+
+	for line in text.splitlines(True):
+		for i, p in enumerate(prefixes):
+			if line.startswith(p) or (' ' + p) in line:
+				current = parts[i]
+				break
+		current.append(line)
+
+	return [''.join(leading + x) for x in parts]
+
+def dependencies(route:files.Path) -> typing.Sequence[files.Path]:
+	"""
+	# Read the prerequisites listed by a compiler emitted, make(1) style,
+	# dependency file. Empty if &route does not exist.
+
+	# Relative paths are interpreted relative to the working directory
+	# that the translations were performed in.
+	"""
+	try:
+		text = route.fs_load().decode('utf-8')
+	except FileNotFoundError:
+		return []
+
+	found = {}
+	for line in text.replace('\\\n', ' ').split('\n'):
+		rule = re.split(r'(?<!\\):(?:\s|$)', line, 1)
+		if len(rule) < 2:
+			continue
+
+		for word in re.split(r'(?<!\\)\s+', rule[1].strip()):
+			if word:
+				found[word.replace('\\ ', ' ').replace('$$', '$')] = None
+
+	return [files.Path.from_path(x) for x in found]
+
+def interpret_reference(cc, ctxpath, _factor, symbol, reference, rreqs={}, rsources=[]):
+	"""
+	# Extract the project identifier from the &url and find a corresponding project.
+
+	# The fragment portion of the URL specifies the factor within the project
+	# that should be connected in order to use the &symbol.
+	"""
+	id = reference_project(reference)
+	if id is None:
+		return
+
+	fpath = reference.factor
 	for ctx in ctxpath:
 		try:
 			pj = ctx.project(id) #* No project in path.
@@ -197,9 +475,12 @@ def interpret_reference(cc, ctxpath, _factor, symbol, reference, rreqs={}, rsour
 				pj, fp, ft, rreqs, rsources,
 				method=reference.method)
 
-def requirements(cc, ctxpath, symbols, factor):
+def requirements(cc, ctxpath, symbols, factor, memo=None):
 	"""
 	# Return the set of factors that is required to build this Target, &factor.
+
+	# When &memo is given, the interpretations of references are recorded
+	# in it by project, factor path, and method and reused.
 	"""
 
 	for sym, refs in factor.symbols.items():
@@ -210,8 +491,197 @@ def requirements(cc, ctxpath, symbols, factor):
 		for r in refs:
 			if isinstance(r, (core.Target, core.SystemFactor)):
 				yield r
-			else:
+			elif memo is None:
 				yield from interpret_reference(cc, ctxpath, factor, sym, r)
+			else:
+				k = (r.project, str(r.factor), r.method)
+				if k not in memo:
+					memo[k] = list(interpret_reference(cc, ctxpath, factor, sym, r))
+				yield from memo[k]
+
+def rss(maxrss:int, platform=sys.platform) -> int:
+	"""
+	# Convert the (id)`ru_maxrss` field of a resource usage record to bytes.
+	"""
+	if platform == 'darwin':
+		return maxrss
+	# Kibibytes on Linux and the BSDs.
+	return maxrss * 1024
+
+def tail(route:files.Path, limit=64*1024) -> typing.Sequence[str]:
+	"""
+	# Read the lines of the last &limit bytes of the file at &route.
+	"""
+	with open(str(route), 'rb') as f:
+		size = f.seek(0, 2)
+		f.seek(max(0, size - limit))
+		data = f.read()
+
+	lines = data.decode('utf-8', 'replace').split('\n')
+	if size > limit:
+		# First line is likely partial.
+		lines[0] = f"[{size - limit} bytes truncated]"
+	return lines
+
+def amalgamate(route:files.Path, sources:typing.Sequence[files.Path]) -> bool:
+	"""
+	# Write the source including each of &sources to &route unless the file
+	# already has the same content. Returns whether the file was written.
+	"""
+	text = ''.join(
+		'#include "' + str(x).replace('\\', '\\\\').replace('"', '\\"') + '"\n'
+		for x in sources
+	).encode('utf-8')
+
+	try:
+		if route.fs_load() == text:
+			return False
+	except FileNotFoundError:
+		pass
+
+	route.fs_alloc().fs_store(text)
+	return True
+
+class Statuses(object):
+	"""
+	# Status reports aggregated across factors and written on an interval.
+
+	# Used in place of per-factor status lines when the transcript's verbosity is low.
+
+	# [ Properties ]
+	# /interval/
+		# The minimum number of seconds between writes.
+	# /counts/
+		# The accumulated instruction counts of each status category.
+	"""
+	descriptions = {
+		'<cached>': "processing instructions skipped",
+		'<stored>': "units retrieved from the artifact store",
+		'<cutoff>': "renders skipped with unchanged units",
+		'<shared>': "units reused from the translations of another variant",
+		'<unity>': "sources translated as amalgamations",
+	}
+
+	def __init__(self, log, interval=1.0, clock=time.monotonic):
+		self.log = log
+		self.interval = interval
+		self.clock = clock
+		self.counts = collections.Counter()
+		self.factors = collections.Counter()
+		self.skipped = collections.Counter()
+		self.last = clock()
+
+	def report(self, category, count, skipped=0):
+		"""
+		# Add &count to the &category and write the aggregate if the interval has passed.
+		"""
+		self.counts[category] += count
+		self.factors[category] += 1
+		self.skipped[category] += skipped
+
+		if self.clock() - self.last >= self.interval:
+			self.flush()
+
+	def flush(self):
+		"""
+		# Write the accumulated reports.
+		"""
+		for category in sorted(self.counts):
+			n = self.counts[category]
+			k = self.skipped[category]
+			ext = {'@metrics': [f'%0+{k}-0/{k}']} if k else {}
+			desc = self.descriptions.get(category, "instructions")
+			self.log.xact_status(category, f"{self.factors[category]} factors: {n} {desc}", ext)
+
+		self.counts.clear()
+		self.factors.clear()
+		self.skipped.clear()
+		self.last = self.clock()
+
+class Processors(object):
+	"""
+	# Subprocess slots shared by a set of &Construction instances.
+
+	# Released slots are signalled to all members so that any
+	# Construction with queued commands may claim them.
+
+	# [ Properties ]
+	# /limit/
+		# The maximum number of concurrent processes.
+	# /phases/
+		# Lower limits for the processes of particular phases; normally
+		# used to constrain memory intensive (id)`render` operations.
+	# /memory/
+		# The number of bytes that the estimates of the running processes
+		# may not exceed; &None if unconstrained.
+	# /reserved/
+		# The sum of the estimates of the running processes.
+	# /estimates/
+		# The peak resident set size observed for a factor's phase.
+	"""
+
+	def __init__(self, limit:int, phases:typing.Mapping[str, int]={}, memory=None):
+		self.limit = limit
+		self.phases = dict(phases)
+		self.count = 0
+		self.counts = collections.Counter()
+		self.members = []
+
+		self.memory = memory
+		self.reserved = 0
+		self.estimates = {} # (factor, phase) -> bytes
+		self.defaults = {} # phase -> bytes; used for factors without history
+
+	def available(self) -> int:
+		"""
+		# The number of slots that may be acquired.
+		"""
+		return self.limit - self.count
+
+	def estimate(self, factor, phase) -> int:
+		"""
+		# The expected memory usage of a &phase process of &factor.
+		"""
+		try:
+			return self.estimates[(factor, phase)]
+		except KeyError:
+			return self.defaults.get(phase, 0)
+
+	def observe(self, factor, phase, memory:int):
+		"""
+		# Record the peak resident set size of a completed process.
+		"""
+		self.estimates[(factor, phase)] = memory
+		self.defaults[phase] = max(memory, self.defaults.get(phase, 0))
+
+	def admits(self, phase, memory=0) -> bool:
+		"""
+		# Whether a process of the given &phase may be started.
+
+		# When a memory budget is configured, processes whose estimate would
+		# exceed it are held unless nothing is running.
+		"""
+		if phase in self.phases:
+			if self.counts[phase] >= self.phases[phase]:
+				return False
+
+		if self.memory is not None and self.count > 0:
+			if self.reserved + memory > self.memory:
+				return False
+
+		return True
+
+	def acquire(self, phase, memory=0):
+		self.count += 1
+		self.counts[phase] += 1
+		self.reserved += memory
+
+	def release(self, phase, memory=0):
+		self.count -= 1
+		self.counts[phase] -= 1
+		self.reserved -= memory
+		for x in self.members:
+			x.process_signal()
 
 class Construction(kcore.Context):
 	"""
@@ -234,20 +704,91 @@ class Construction(kcore.Context):
 			factors,
 			reconstruct=False,
 			processors=4,
+			digests=False,
+			status=None,
+			pool=None,
+			costs=None,
+			pipeline=frozenset(),
+			references=None,
+			batch=False,
+			store=None,
+			cutoff=False,
+			trace=None,
+			history=None,
+			verbosity=2,
+			spawn=None,
+			workers=None,
+			remote=None,
+			mechanisms=None,
+			dirty=None,
+			statuses=None,
+			unity=None,
+			unity_size=8,
+			prerequisites=None,
 		):
 		super().__init__()
 
 		self._etime = time
 		self._rusage = {}
-		self._mcache = {}
+		self._mcache = mechanisms if mechanisms is not None else {}
+		self.c_dirty = dirty # Factors affected by changes; &None if unknown.
 		self.log = log
 		self._end_of_factors = False
 
 		self.reconstruct = reconstruct
+		self.digests = digests
+		self._records = {} # output -> (digest record, inputs, plan, dependency file)
+		self._batches = {} # first unit -> ((unit, log), ...) of batched translations
+		self._diagnostics = {} # first unit -> (source, ...) dividing the batch's log
+		self._shared = {} # unit -> [(unit, log), ...] of other variants reusing the translation
+		self.c_batch = batch
+
+		# Shared artifact store and the host specific prefixes removed from its keys.
+		self.c_store = store
+		self.c_relative = ((str(cache.route), '<cache>'), (os.getcwd(), '<work>'))
+		self._deposits = {} # output -> (inputs, plan, dependency file)
+		self._reservations = {} # output -> memory estimate of the running process
+
+		# Skip renders whose units were translated without change.
+		self.c_cutoff = cutoff
+
+		# Selected intentions and factor paths whose sources are amalgamated.
+		if unity is not None:
+			self.c_unity = (
+				frozenset(x for x in unity if x in intentions),
+				tuple(x for x in unity if x not in intentions),
+			)
+		else:
+			self.c_unity = None
+		self.c_unity_size = unity_size
+
+		# Paths listed by the dependency files; collected for watch mode.
+		self.c_prerequisites = prerequisites
+
+		# Trace event record and operation history.
+		self.c_trace = trace
+		self.c_history = history
+		self._labels = {} # output -> (variant, source)
+		self._expected = {} # factor -> nanoseconds of work according to &c_history
 		self.failures = 0
 		self.exits = 0
 		self.c_sequence = None
 
+		# Transcript detail; plans are only serialized above one and
+		# status reports are aggregated by &c_statuses below one.
+		self.c_verbosity = verbosity
+		self.c_statuses = statuses
+		# Launch method; &None for &libexec.KInvocation.spawn.
+		self.c_spawn = spawn
+		# Persistent workers for translations of contexts declaring a worker mode.
+		self.c_workers = workers
+		self._requests = set() # Worker requests in flight; not kernel transactions.
+
+		# Command shipping instructions to remote hosts; see &manifest.
+		self.c_remote = remote
+		self._manifests = {} # output -> (inputs, outputs)
+		self._members = {} # amalgamation -> member sources
+
 		self.c_intentions = intentions
 		self.c_form = form
 		self.c_executor = executor
@@ -258,13 +799,32 @@ class Construction(kcore.Context):
 		self.c_symbols = symbols
 		self.c_context = context
 		self.c_factors = factors
-
-		self.tracking = collections.defaultdict(list) # factor -> sequence of sets of tasks
-		self.progress = collections.Counter()
-
-		self.process_count = 0 # Track available subprocess slots.
-		self.process_limit = processors
-		self.command_queue = collections.deque()
+		self.c_status = status if status is not None else fscache.Status()
+		self.c_references = references if references is not None else {}
+
+		# Variants of a factor are processed as independent tracks, lanes,
+		# identified by the factor and the variant's work key.
+		self.tracking = collections.defaultdict(list) # lane -> sequence of sets of tasks
+		self.progress = collections.Counter() # lane -> completed tasks of the current set
+		self.lanes = {} # factor -> set of incomplete lanes
+		self.awaiting = {} # lane -> lanes translating units reused by the lane
+
+		# Track available subprocess slots; possibly shared with other Constructions.
+		self.process_pool = pool if pool is not None else Processors(processors)
+		self.process_pool.members.append(self)
+		# Heap of (-priority, order, instruction); critical path first.
+		self.command_queue = []
+		self.command_order = itertools.count()
+		self.priority = {} # factor -> weight reported by &graph.sequence
+		self.c_costs = costs
+		if costs is None and history is not None:
+			self.c_costs = functools.partial(weight, history)
+
+		# Factor types whose dependents may translate before their completion.
+		self.c_pipeline = pipeline
+		self.released = set() # Reported to &c_sequence before completion.
+		self.pending = {} # factor -> set of released requirements
+		self.held = set() # Lanes whose render is waiting on &pending or &awaiting.
 
 		self.continued = False
 		self.activity = set()
@@ -273,22 +833,37 @@ class Construction(kcore.Context):
 		return sysclock.elapsed().decrease(self._etime)
 
 	def actuate(self):
+		check = identical if self.digests else updated
+		status = self.c_status
+
 		if self.reconstruct:
 			if self.reconstruct > 1:
-				self._filter = functools.partial(updated, never=True, cascade=True)
+				self._filter = functools.partial(check, never=True, cascade=True, status=status)
 			else:
-				self._filter = functools.partial(updated, never=True, cascade=False)
+				self._filter = functools.partial(check, never=True, cascade=False, status=status)
 		else:
-			self._filter = functools.partial(updated)
+			self._filter = functools.partial(check, status=status)
 
-		descent = functools.partial(requirements, self.c_context, self.c_ctxpath, self.c_symbols)
+		descent = functools.partial(requirements,
+			self.c_context, self.c_ctxpath, self.c_symbols,
+			memo=self.c_references
+		)
 
 		# Manages the dependency order.
-		self.c_sequence = graph.sequence(descent, self.c_factors)
+		if self.c_costs is not None:
+			self.c_sequence = graph.sequence(descent, self.c_factors, cost=self.c_costs, dirty=self.c_dirty)
+		else:
+			self.c_sequence = graph.sequence(descent, self.c_factors, dirty=self.c_dirty)
 
 		initial = next(self.c_sequence)
 		assert initial is None # generator init
 
+		if self.c_history is not None:
+			self._expected = {
+				x: self.c_history.factor(x.absolute_path_string) or 0
+				for x in self.c_factors
+			}
+
 		self.finish(())
 		self.drain_process_queue()
 
@@ -305,27 +880,94 @@ class Construction(kcore.Context):
 		"""
 		# Called when a set of factors have been completed.
 		"""
-		try:
-			for x in factors:
-				del self.progress[x]
-				del self.tracking[x]
+		for x in factors:
+			self.priority.pop(x, None)
+			self.pending.pop(x, None)
+
+		if factors and self._expected and self.c_verbosity > 0:
+			self.estimate(factors)
+
+		if self.held:
+			# Held renders may be waiting on the completed factors.
+			self.activity.update(self.held)
+			self.held.clear()
+
+			if self.continued is False:
+				self.continued = True
+				self.enqueue(self.continuation)
+
+		# Released factors have already been reported to the sequence.
+		early = self.released.intersection(factors)
+		self.released.difference_update(early)
+		self.release([x for x in factors if x not in early])
+
+		if self._end_of_factors and not self.tracking and not self._requests:
+			self.xact_exit_if_empty()
+
+	def status(self, category, factor, synopsis, count, skipped=0):
+		"""
+		# Report the status of &factor's processing or add it to the aggregate.
+		"""
+		if self.c_statuses is not None:
+			self.c_statuses.report(category, count, skipped)
+		else:
+			ext = {'@metrics': [f'%0+{skipped}-0/{skipped}']} if skipped else {}
+			self.log.xact_status(category, f"{factor.name}: {synopsis}", ext)
 
-			work, reqs, deps = self.c_sequence.send(factors) # raises StopIteration
+	def estimate(self, factors):
+		"""
+		# Report the work remaining after the completion of &factors
+		# according to the durations of previous builds.
+		"""
+		for x in factors:
+			self._expected.pop(x, None)
+		remaining = sum(self._expected.values())
+
+		# Presume that the process slots remain occupied.
+		eta = remaining // max(1, self.process_pool.limit) // (10**9)
+		self.log.xact_status('<eta>',
+			f"{self.c_project.factor}: {remaining // (10**9)}s of work, ~{eta}s remaining", {}
+		)
+
+	def release(self, factors):
+		"""
+		# Report the completion of &factors to the sequence and collect
+		# the factors that can now be processed.
+		"""
+		while True:
+			try:
+				work, reqs, deps, weights = self.c_sequence.send(factors)
+			except StopIteration:
+				self._end_of_factors = True
+				if not self.tracking and not self._requests:
+					self.xact_exit_if_empty()
+				return
+
+			self.priority.update(weights)
+			factors = []
 			for target in work:
 				if isinstance(target, core.SystemFactor):
-					self.tracking[target] = []
 					self.finish([target])
 				else:
 					ftype = _ftype(target.type)
 					fr = reqs.get(target, ())
 					fd = deps.get(target, ())
 					self.collect(self.select(ftype), target, fr, fd)
-		except StopIteration:
-			self._end_of_factors = True
-			self.xact_exit_if_empty()
+
+					if self.c_pipeline and target in self.lanes:
+						if _fidentifier(target.type) in self.c_pipeline:
+							# Dependents only need the image when rendering.
+							self.released.add(target)
+							factors.append(target)
+
+			if not factors:
+				break
 
 	def xact_void(self, final):
-		if self._end_of_factors:
+		# Released factors may end the sequence while their lanes are
+		# still being processed; void is also seen between instruction sets.
+		if self._end_of_factors and not self.tracking and not self._requests:
+			self.process_pool.members.remove(self)
 			self.finish_termination()
 
 	def _prepare_work_directory(self, locations, sources):
@@ -336,6 +978,7 @@ class Construction(kcore.Context):
 		ftr = locations['factor-image']
 		units = locations['unit-directory']
 		logs = locations['log-directory']
+		digests = locations.get('digest-directory')
 
 		workdir = ftr.container
 		workdir.fs_mkdir()
@@ -348,6 +991,11 @@ class Construction(kcore.Context):
 			log = files.Path(logs, src.points[:-1])
 			emitted.update((unit, log))
 
+		if digests is not None:
+			emitted.add(digests)
+			for srcfmt, src in sources:
+				emitted.add(files.Path(digests, src.points[:-1]))
+
 		for x in emitted:
 			if x.fs_type() == 'void':
 				x.fs_alloc().fs_mkdir()
@@ -373,7 +1021,20 @@ class Construction(kcore.Context):
 		# /dependents/
 			# The set of factors that refer to &factor.
 		"""
-		tracks = self.tracking[factor]
+		lanes = set()
+		vset = list(mechanism.variants(self.c_intentions, form=self.c_form))
+
+		# Normalized translation plans of the outdated units -> (lane, unit).
+		# Variants composing the same command reuse the unit of the first.
+		shared = {}
+
+		# Released requirements that have not completed.
+		pending = set()
+		if self.released and requirements:
+			for rset in requirements.values():
+				pending.update(r for r in rset if r in self.released)
+			if pending:
+				self.pending[factor] = pending
 
 		# Subfactor of c_factor (selected path)
 		subfactor = (factor.project.factor == self.c_project.factor)
@@ -382,13 +1043,13 @@ class Construction(kcore.Context):
 		# Execution override for supporting command tracing and usage constraints.
 		exe = self.c_executor
 		skipped = 0
-		nsources = len(factor.sources())
 
-		for section, variants in mechanism.variants(self.c_intentions, form=self.c_form):
+		for section, variants in vset:
 			u_prefix, u_suffix = mechanism.unit_name_delta(section, variants, factor.type)
 
 			image = factor.image(variants)
 			key = work(variants, factor.name)
+			lane = (factor, key)
 			cdr = self.c_cache.select(factor.project.factor, factor.route, key)
 			locations = {
 				'factor-image': image,
@@ -396,6 +1057,8 @@ class Construction(kcore.Context):
 				'log-directory': (cdr / 'log').delimit(),
 				'unit-directory': (cdr / 'units').delimit(),
 			}
+			if self.digests:
+				locations['digest-directory'] = (cdr / 'digests').delimit()
 
 			fint = core.Integrand((
 				mechanism, factor,
@@ -408,35 +1071,146 @@ class Construction(kcore.Context):
 			self._prepare_work_directory(locations, factor.sources())
 			logs = locations['log-directory']
 			units = locations['unit-directory']
+			digests = locations.get('digest-directory')
+
+			# Precompiled headers or interfaces referenced by the translations.
+			preparations, prepared = self._preparations(mechanism, fint, section, variants, xfilter)
+
+			if self._unified(factor, variants):
+				sources = self._unify(factor, cdr)
+			else:
+				sources = factor.sources()
+			nsources = len(sources)
 
 			translations = []
+			fetched = 0
+			reused = 0
 			unitseq = []
-			for fmt, src in factor.sources():
+			unitpaths = []
+			outdated = collections.defaultdict(list) # fmt -> [(src, unit, log, ins)]
+			unitinputs = {} # unit -> declared inputs of its translation
+			candidates = [] # (fmt, src, unit, log, ins, inputs) of the outdated units
+			lookups = {} # unit -> (inputs, plan, dependency file) of its store key
+			for fmt, src in sources:
 				unit_name = u_prefix + src.identifier + u_suffix
 				tlout = files.Path(units, src.points[:-1] + (unit_name,))
 				unitseq.append(str(tlout))
+				unitpaths.append(tlout)
 
-				if xfilter((tlout,), (src,)):
-					continue
+				artifact, stale = prepared.get(fmt, (None, False))
+				if artifact is not None:
+					# Translated again when the artifact is prepared.
+					base = (src, artifact)
+				else:
+					base = (src,)
 
+				# Headers recorded by the previous translation.
 				tllog = files.Path(logs, src.points)
-				cmd, tlc = mechanism.translate(section, variants, factor.type, fmt)
-				local = {
-					'source': str(src),
-					'unit': str(tlout),
-					'language': fmt.format.language,
-					'dialect': fmt.format.dialect,
+				depfile = self._dependency_file(tllog)
+				inputs = base + tuple(dependencies(depfile))
+				if self.c_prerequisites is not None:
+					self.c_prerequisites.update(map(str, inputs[len(base):]))
+
+				if digests is None and not stale and self._present(inputs[len(base):]) and xfilter((tlout,), inputs):
+					continue
+
+				if digests is None and self.c_store is None and len(vset) < 2:
+					# Composed when the batch possibility has been identified.
+					ins = None
+				else:
+					# Content checks and store lookups require the composed command.
+					ins = self._translation(mechanism, fint, section, variants, fmt, src, tlout, tllog, prepared)
+
+					if digests is not None:
+						record = files.Path(digests, src.points)
+						if not stale and xfilter((tlout,), record, digest(inputs, ins[5])):
+							continue
+						self._records[tlout] = (record, base, ins[5], depfile)
+
+					if self.c_store is not None:
+						if stale:
+							# The artifact's content is not yet known;
+							# keyed by the dependencies written by the translation.
+							self._deposits[tlout] = (base, ins[5], depfile)
+						else:
+							lookups[tlout] = (base, ins[5], depfile)
+
+				candidates.append((fmt, src, tlout, tllog, ins, inputs))
+
+			# Performed together so that remote stores may overlap the requests.
+			found = self._fetch_all(lookups) if lookups else ()
+			fetched += len(found)
+
+			for fmt, src, tlout, tllog, ins, inputs in candidates:
+				if tlout in found:
+					continue
+
+				if len(vset) > 1:
+					settings, xpath, xargs = ins[5]
+					wd = str(cdr)
+					plan = (
+						tuple(map(tuple, settings)), xpath,
+						tuple(x.replace(wd, '') for x in xargs),
+					)
+					if plan in shared:
+						# Intention invariant; copied from the other variant's unit.
+						olane, ounit = shared[plan]
+						self._shared.setdefault(ounit, []).append((tlout, tllog))
+						self.awaiting.setdefault(lane, set()).add(olane)
+						reused += 1
+						continue
+					shared[plan] = (lane, tlout)
+
+				outdated[fmt].append((src, tlout, tllog, ins))
+				unitinputs[tlout] = inputs
+
+			for fmt, group in outdated.items():
+				limit = 0
+				if self.c_batch and len(group) > 1:
+					limit = mechanism.batch_limit(section, variants, factor.type, fmt)
+
+				if limit > 1:
+					for i in range(0, len(group), limit):
+						translations.append(
+							self._batch(mechanism, fint, section, variants, fmt, group[i:i+limit], prepared)
+						)
+				else:
+					for src, tlout, tllog, ins in group:
+						if ins is None:
+							ins = self._translation(mechanism, fint, section, variants, fmt, src, tlout, tllog, prepared)
+						translations.append(ins)
+
+			ntranslations = sum(map(len, outdated.values()))
+			tracks = self.tracking[lane]
+			if preparations:
+				tracks.append(('prepare', preparations, None))
+			tracks.append(('translate', translations, None))
+			lanes.add(lane)
+
+			# Content of the units prior to translation for render cutoff.
+			cutoff = None
+			if self.c_cutoff and translations and not (fetched or reused or pending):
+				cutoff = {
+					x[1]: _content(x[1])
+					for group in outdated.values()
+					for x in group
 				}
-				q = tools.partial(local_query, fint, local)
+				if None in cutoff.values():
+					# New units always render.
+					cutoff = None
 
-				args = tlc(q)
-				translations.append(prepare(cmd, args, tllog, tlout, src, executor=exe))
+			condition = None
 
-			tracks.append(('translate', translations))
+			if digests is None:
+				rendered = translations or fetched or reused or pending
+				rendered = rendered or not xfilter((image,), fint.required(variants))
+			else:
+				rendered = True
 
-			if translations or not xfilter((image,), fint.required(variants)):
-				# Build is triggered unconditionally if any translations are performed
-				# or if the target image is older than any requirement image.
+			if rendered:
+				# Build is triggered unconditionally if any translations are performed,
+				# if the target image is older than any requirement image, or if
+				# a requirement's image is still being processed.
 
 				cmd, ric = mechanism.render(section, variants, factor.type)
 				local = {
@@ -449,77 +1223,506 @@ class Construction(kcore.Context):
 				render = ric(q)
 				rlog = files.Path(logs, ('Integration',))
 				ops = [prepare(cmd, render, rlog, image, src, executor=exe)]
+
+				inputs = unitpaths + list(fint.required(variants))
+				plan = ops[0][5]
+
+				if digests is not None:
+					record = files.Path(digests, ('Integration',))
+					if not (translations or fetched or reused or pending) and xfilter((image,), record, digest(inputs, plan)):
+						ops = []
+					else:
+						self._records[image] = (record, inputs, plan, None)
+
+				if ops and self.c_store is not None:
+					if translations or reused or pending:
+						# Inputs are not yet available; deposit the result.
+						self._deposits[image] = (inputs, plan, None)
+					elif self._fetch(image, inputs, plan):
+						ops = []
+
+				if ops and cutoff is not None:
+					# Render is only necessary if the translations change the units.
+					if digests is None:
+						current = xfilter((image,), fint.required(variants))
+					else:
+						current = xfilter((image,), record, digest(inputs, plan))
+
+					if current:
+						condition = functools.partial(self._changed, cutoff)
 			else:
 				ops = []
 
-			tracks.append(('render', ops))
+			tracks.append(('render', ops, condition))
+
+			if self.c_trace is not None or self.c_history is not None:
+				label = '/'.join(str(v) for k, v in sorted(variants.items()) if k != 'name')
+				sources = {
+					x[1]: '/'.join(x[0].points)
+					for group in outdated.values()
+					for x in group
+				}
+				for x in itertools.chain(preparations, translations, ops):
+					self._labels[x[1]] = (label, sources.get(x[1], ''))
+
+			if self.c_remote is not None:
+				# The files that must be shipped to and retrieved from the remote host.
+				for x in translations:
+					members = self._batches.get(x[1]) or ((x[1], x[4]),)
+					declared = {str(i) for m in members for i in unitinputs[m[0]]}
+					# Headers are only listed after the first translation.
+					declared.update(directories(x[5][2]))
+					for m in members:
+						declared.update(self._members.get(str(unitinputs[m[0]][0]), ()))
+					outputs = [str(m[0]) for m in members]
+					outputs.extend(str(self._dependency_file(m[1])) for m in members)
+					self._manifests[x[1]] = (transferred(declared), outputs)
+				for x in ops:
+					self._manifests[x[1]] = (transferred(inputs), [str(x[1])])
 
 			# Communicate the changes to pending work. Skips and remainder.
-			skip = (nsources - len(translations)) + (1 if len(ops) == 0 else 0)
+			skip = (nsources - ntranslations - reused) + (1 if len(ops) == 0 else 0)
+			if fetched:
+				self.status('<stored>', factor,
+					f"{fetched} units retrieved from the artifact store", fetched
+				)
+			if reused:
+				self.status('<shared>', factor,
+					f"{reused} units reused from the translations of another variant", reused
+				)
 			skipped += skip
-			ext = {
-				'@metrics': [f'%0+{skip}-0/{skip}'],
-			}
-			self.log.xact_status('<cached>',
-				f"{factor.name}: {skip} procssing instructions skipped", ext
+			self.status('<cached>', factor,
+				f"{skip} procssing instructions skipped", skip, skip
 			)
 
-		if tracks:
-			self.progress[factor] = -1
-			self.dispatch(factor)
+		if lanes:
+			self.lanes[factor] = lanes
+			for lane in lanes:
+				self.progress[lane] = -1
+				self.dispatch(lane)
 		else:
-			self.activity.add(factor)
+			# Empty lane completing the factor.
+			self.activity.add((factor, None))
 
 			if self.continued is False:
 				# Consolidate loading of the next set of processors.
 				self.continued = True
 				self.enqueue(self.continuation)
 
+	def _fetch(self, output, inputs, plan, depfile=None):
+		"""
+		# Retrieve &output from the artifact store. When absent, note that
+		# &output should be deposited after it has been processed.
+		"""
+		return output in self._fetch_all({output: (inputs, plan, depfile)})
+
+	def _fetch_all(self, lookups):
+		"""
+		# Retrieve the outputs of &lookups from the artifact store; returns the
+		# set of outputs retrieved. Outputs that are absent are noted for deposit.
+
+		# Outputs with a dependency file are retrieved in two rounds. The dependency
+		# file stored under the key of the inputs and the plan is retrieved first,
+		# and the prerequisites it lists select the key of the output. Hosts without
+		# a prior translation, and so without a local dependency file, are able to
+		# retrieve the output as well.
+		"""
+		if not self.c_store.available:
+			self._deposits.update(lookups)
+			return set()
+
+		requests = []
+		manifests = {}
+		for output, (inputs, plan, depfile) in lookups.items():
+			key = digest(inputs, plan, relative=self.c_relative).decode('ascii')
+			if depfile is None:
+				requests.append((key, output))
+			else:
+				stored = self._stored_dependencies(depfile)
+				manifests[stored] = output
+				requests.append((key + '.d', stored))
+
+		# Dependency files, then the outputs keyed by their prerequisites.
+		found = self.c_store.fetch_all(requests)
+		requests = [(k, t) for k, t in requests if t not in manifests]
+		for stored in found.intersection(manifests):
+			output = manifests[stored]
+			inputs, plan, depfile = lookups[output]
+
+			text = relocate(stored.fs_load().decode('utf-8'), self.c_relative, restore=True)
+			stored.fs_store(text.encode('utf-8'))
+			key = digest(self._inputs(inputs, stored), plan, relative=self.c_relative)
+			requests.append((key.decode('ascii'), output))
+
+		found = self.c_store.fetch_all(requests) if requests else set()
+		for output, deposit in lookups.items():
+			if output not in found:
+				self._deposits[output] = deposit
+				continue
+
+			self.c_status.invalidate(output)
+			depfile = deposit[2]
+			if depfile is not None:
+				# The prerequisites of the retrieved output.
+				os.replace(str(self._stored_dependencies(depfile)), str(depfile))
+				self.c_status.invalidate(depfile)
+				if self.c_prerequisites is not None:
+					self.c_prerequisites.update(map(str, dependencies(depfile)))
+
+			record = self._records.pop(output, None)
+			if record is not None:
+				dr, rinputs, rplan, rdeps = record
+				dr.fs_store(digest(self._inputs(rinputs, rdeps), rplan))
+
+		return found
+
+	def _deposit(self, output, inputs, plan, depfile):
+		"""
+		# Record &output in the artifact store. When &depfile is present, the output
+		# is keyed by the prerequisites it lists and the dependency file is recorded,
+		# with host independent paths, under the key of &inputs and &plan.
+		"""
+		if depfile is None:
+			key = digest(inputs, plan, relative=self.c_relative)
+			self.c_store.deposit(key.decode('ascii'), output)
+			return
+
+		try:
+			text = depfile.fs_load().decode('utf-8')
+		except FileNotFoundError:
+			# Not retrievable by other hosts without the prerequisites.
+			return
+
+		key = digest(self._inputs(inputs, depfile), plan, relative=self.c_relative)
+		self.c_store.deposit(key.decode('ascii'), output)
+
+		# A new file as the store may link to the one previously deposited.
+		stored = self._stored_dependencies(depfile)
+		stage.detach(stored)
+		stored.fs_store(relocate(text, self.c_relative).encode('utf-8'))
+		key = digest(inputs, plan, relative=self.c_relative)
+		self.c_store.deposit(key.decode('ascii') + '.d', stored)
+
+	def _present(self, prerequisites) -> bool:
+		"""
+		# Whether the &prerequisites listed by a dependency file exist.
+
+		# &updated passes over absent inputs; a header that was removed or
+		# renamed requires the translation so that its absence is reported.
+		"""
+		return all(self.c_status(x) is not None for x in prerequisites)
+
+	@staticmethod
+	def _inputs(inputs, depfile):
+		# The &inputs extended with the prerequisites currently listed by &depfile.
+		if depfile is None:
+			return inputs
+		return tuple(inputs) + tuple(dependencies(depfile))
+
+	@staticmethod
+	def _changed(prior):
+		# Whether any of the units differ from their content prior to translation.
+		return any(_content(unit) != state for unit, state in prior.items())
+
+	@staticmethod
+	def _dependency_file(log):
+		# Location of the dependency file emitted by the translation whose
+		# standard error is written to &log.
+		return log.container / (log.identifier + '.d')
+
+	@staticmethod
+	def _stored_dependencies(depfile):
+		# Location of the copy of &depfile exchanged with the artifact store.
+		return depfile.container / (depfile.identifier + '.store')
+
+	def _unified(self, factor, variants) -> bool:
+		"""
+		# Whether the sources of &factor are amalgamated for &variants.
+
+		# When both intentions and factor paths are selected, both must match.
+		"""
+		if self.c_unity is None or _fidentifier(factor.type) not in core.unified:
+			return False
+
+		intentions, paths = self.c_unity
+		if intentions and variants.intention not in intentions:
+			return False
+
+		if paths:
+			fp = factor.absolute_path_string
+			return any(fp == x or fp.startswith(x + '.') for x in paths)
+
+		return True
+
+	def _unify(self, factor, cdr):
+		"""
+		# Write the amalgamated sources of &factor into the work directory, &cdr,
+		# and construct the source list translating them in place of their members.
+
+		# Sources are grouped by format and chunked by &c_unity_size in path order
+		# so that the membership of a chunk is stable across builds.
+		"""
+		sources = []
+		groups = collections.defaultdict(list)
+		for fmt, src in factor.sources():
+			if fmt.format.language in core.unified_languages:
+				groups[fmt].append(src)
+			else:
+				sources.append((fmt, src))
+
+		udir = (cdr / 'unity').delimit()
+		size = max(1, self.c_unity_size)
+		n = 0
+		for fmt, group in groups.items():
+			group.sort(key=str)
+			lname = '.'.join(x for x in (fmt.format.language, fmt.format.dialect) if x)
+
+			for i in range(0, len(group), size):
+				chunk = group[i:i+size]
+				if len(chunk) == 1:
+					sources.append((fmt, chunk[0]))
+					continue
+
+				# Extension of the members for the compiler's language detection.
+				name = 'Unity.' + lname + '.' + str(i // size) + os.path.splitext(chunk[0].identifier)[1]
+				amalgamation = files.Path(udir, (name,))
+				if amalgamate(amalgamation, chunk):
+					self.c_status.invalidate(amalgamation)
+				self._members[str(amalgamation)] = [str(x) for x in chunk]
+				sources.append((fmt, amalgamation))
+				n += len(chunk)
+
+		if n:
+			self.status('<unity>', factor, f"{n} sources translated as amalgamations", n)
+		return sources
+
+	@staticmethod
+	def _prepared(prepared, fmt):
+		# The (id)`prepared` local query of the translations of &fmt; empty when
+		# the context does not prepare headers for the format.
+		if fmt in prepared:
+			return [str(prepared[fmt][0])]
+		return []
+
+	def _preparations(self, mechanism, fint, section, variants, xfilter):
+		"""
+		# Construct the instructions preparing the headers declared by the context's
+		# Prepare phase for the source formats of the factor.
+
+		# Returns the instructions of the outdated artifacts and a mapping of the
+		# source formats to their artifact and whether it is being prepared.
+		"""
+		factor = fint.factor
+		locations = fint.locations
+		logs = locations['log-directory']
+		units = locations['unit-directory']
+		digests = locations.get('digest-directory')
+
+		instructions = []
+		prepared = {}
+		sources = {'/'.join(src.points): src for fmt, src in factor.sources()}
+		# The factor's source directory; resolves other relative header paths.
+		root = str(next(iter(sources.values())).context) if sources else None
+
+		for fmt in dict.fromkeys(x[0] for x in factor.sources()):
+			p = mechanism.preparation(section, variants, factor.type, fmt)
+			if p is None:
+				continue
+
+			# Factor relative paths select sources; other relative paths are
+			# interpreted relative to the factor's source directory.
+			names, suffix = p
+			headers = [
+				sources[x] if x in sources else
+				files.Path.from_absolute(os.path.normpath(os.path.join(root, x)))
+				for x in names
+			]
+
+			lname = '.'.join(x for x in (fmt.format.language, fmt.format.dialect) if x)
+			artifact = files.Path(units, ('Prepared.' + lname + suffix,))
+			log = files.Path(logs, ('Prepared.' + lname,))
+			depfile = self._dependency_file(log)
+			inputs = tuple(headers) + tuple(dependencies(depfile))
+			if self.c_prerequisites is not None:
+				self.c_prerequisites.update(map(str, inputs))
+
+			if digests is None and self._present(inputs) and xfilter((artifact,), inputs):
+				prepared[fmt] = (artifact, False)
+				continue
+
+			cmd, pc = mechanism.prepare(section, variants, factor.type, fmt)
+			local = {
+				'headers': [str(x) for x in headers],
+				'header': str(headers[0]),
+				'prepared': str(artifact),
+				'dependencies': str(self._dependency_file(log)),
+				'language': fmt.format.language,
+				'dialect': fmt.format.dialect,
+			}
+			q = tools.partial(local_query, fint, local)
+			ins = prepare(cmd, pc(q), log, artifact, headers[0], executor=self.c_executor)
+
+			if digests is not None:
+				record = files.Path(digests, ('Prepared.' + lname,))
+				if xfilter((artifact,), record, digest(inputs, ins[5])):
+					prepared[fmt] = (artifact, False)
+					continue
+				self._records[artifact] = (record, tuple(headers), ins[5], depfile)
+
+			if self.c_remote is not None:
+				self._manifests[artifact] = (
+					transferred(itertools.chain(inputs, directories(ins[5][2]))),
+					[str(artifact), str(self._dependency_file(log))],
+				)
+
+			prepared[fmt] = (artifact, True)
+			instructions.append(ins)
+
+		return instructions, prepared
+
+	def _translation(self, mechanism, fint, section, variants, fmt, src, unit, log, prepared={}):
+		"""
+		# Construct the instruction translating &src into &unit.
+		"""
+		cmd, tlc = mechanism.translate(section, variants, fint.itype, fmt)
+		local = {
+			'source': str(src),
+			'unit': str(unit),
+			'dependencies': str(self._dependency_file(log)),
+			'prepared': self._prepared(prepared, fmt),
+			'language': fmt.format.language,
+			'dialect': fmt.format.dialect,
+		}
+		q = tools.partial(local_query, fint, local)
+
+		ins = prepare(cmd, tlc(q), log, unit, src, executor=self.c_executor)
+		if self.c_workers is not None:
+			wargs = mechanism.worker(section, variants, fint.itype, fmt)
+			if wargs is not None:
+				# Replace the invocation with a request to the template's workers.
+				settings, xpath, xargs = ins[5]
+				n = len(cmd[2])
+				template = (xpath, tuple(xargs[:n]) + tuple(wargs), tuple(map(tuple, settings)))
+				ins = ins[:6] + (persistent.Request(template, xargs[n:]),)
+
+		return ins
+
+	def _batch(self, mechanism, fint, section, variants, fmt, group, prepared={}):
+		"""
+		# Construct the instruction translating the sources of &group with one command.
+
+		# The standard error of the command is written to a log beside the first
+		# source's log and placed at each of the unit's log locations upon exit.
+		# The diagnostics are not divided; each unit's log is the whole batch log.
+		"""
+		cmd, tlc = mechanism.batch(section, variants, fint.itype, fmt)
+		local = {
+			'sources': [str(x[0]) for x in group],
+			'units': [str(x[1]) for x in group],
+			'dependencies': [str(self._dependency_file(x[2])) for x in group],
+			'prepared': self._prepared(prepared, fmt),
+			'language': fmt.format.language,
+			'dialect': fmt.format.dialect,
+		}
+		q = tools.partial(local_query, fint, local)
+
+		src, unit, log, ins = group[0]
+		blog = log.container / (log.identifier + '.batch')
+		self._batches[unit] = tuple((x[1], x[2]) for x in group)
+		self._diagnostics[unit] = tuple(str(x[0]) for x in group)
+
+		return prepare(cmd, tlc(q), blog, unit, src, executor=self.c_executor)
+
 	def _reapusage(self, pid, partial=functools.partial):
 		deliver = partial(self._rusage.__setitem__, pid)
 		wait = partial(libexec.waitrusage, deliver)
 		return partial(libexec.reap, sysop=wait)
 
 	def process_execute(self, instruction, f_target_path=(lambda x: str(x))):
-		phase, factor, ins = instruction
+		phase, lane, ins = instruction
+		factor = lane[0]
 		opid, tfile, cin, cout, cerr, cmd, ki = ins
 
 		pid = None
+		xact = None
 		start_time = self.time()
+		params = (start_time, lane, cerr, opid, tfile, phase, cout)
+
+		# Outputs placed by links are replaced rather than written through.
+		for output, olog in self._batches.get(tfile) or ((tfile, None),):
+			stage.detach(output)
+			# Rewritten in place by the compilers' (id)`-MD` option.
+			stage.detach(self._dependency_file(olog or cerr))
+			if olog is not None:
+				stage.detach(olog)
+		stage.detach(cout)
+		stage.detach(cerr)
+
+		if self.c_remote is not None and not isinstance(ki, persistent.Request):
+			# Standard I/O is relayed by the dispatch command.
+			mf = cerr.container / (cerr.identifier + '.dispatch')
+			mf.fs_store(manifest(cmd, *self._manifests.pop(tfile, ((), (str(tfile),)))))
+			xpath = str(self.c_remote)
+			launch = ((), xpath, [xpath, str(mf)])
+			ki = libexec.KInvocation(xpath, launch[2], environ=environment(()))
+		else:
+			launch = cmd
 
-		with cin.fs_open('rb') as ci:
-			with cerr.fs_open('wb') as cl:
-				with cout.fs_open('wb') as co:
-					pid = ki.spawn(fdmap=(
-						(ci.fileno(), 0),
-						(co.fileno(), 1),
-						(cl.fileno(), 2),
-					))
-					sp = kdispatch.Subprocess(self._reapusage(pid), {
-						pid: (start_time, factor, cerr, opid, tfile)
-					})
+		if isinstance(ki, persistent.Request):
+			# Performed by a persistent worker; no transaction to dispatch.
+			pid = self.c_workers.submit(ki, cin, cout, cerr,
+				functools.partial(self._worker_exit, params)
+			)
+			self._requests.add(pid)
+		else:
+			fds = []
+			try:
+				fds.append(os.open(str(cin), os.O_RDONLY|os.O_CLOEXEC))
+				fds.append(os.open(str(cout), os.O_WRONLY|os.O_CREAT|os.O_TRUNC|os.O_CLOEXEC, 0o666))
+				fds.append(os.open(str(cerr), os.O_WRONLY|os.O_CREAT|os.O_TRUNC|os.O_CLOEXEC, 0o666))
+				fdmap = tuple(zip(fds, (0, 1, 2)))
+
+				if self.c_spawn is not None:
+					pid = self.c_spawn(launch[1], launch[2], environment(launch[0]), fdmap)
+				else:
+					pid = ki.spawn(fdmap=fdmap)
+			finally:
+				for fd in fds:
+					os.close(fd)
+
+			sp = kdispatch.Subprocess(self._reapusage(pid), {pid: params})
 			xact = kcore.Transaction.create(sp)
 
-		env = [
-			('@STDERR', str(cerr)),
-			('@STDOUT', str(cout)),
-			('@STDIN', str(cin)),
-		]
-		env.extend(cmd[0])
-		plan = ''.join(libexec.serialize_sx_plan((env, cmd[1], cmd[2])))
+		if self.c_trace is not None:
+			self.c_trace.start(pid)
 
 		ext = {
 			'@metrics': ['%0+0-0/1'],
 			'@type': ['system'],
-			'@operation': ['#!/usr/bin/env px'] + plan.split('\n'),
 			'factor': [str(factor.route)],
 		}
+
+		if self.c_verbosity > 1:
+			env = [
+				('@STDERR', str(cerr)),
+				('@STDOUT', str(cout)),
+				('@STDIN', str(cin)),
+			]
+			env.extend(cmd[0])
+			plan = ''.join(libexec.serialize_sx_plan((env, cmd[1], cmd[2])))
+			ext['@operation'] = ['#!/usr/bin/env px'] + plan.split('\n')
 		synop = ' '.join(("FPI:", str(factor), str(tfile)))
 		self.log.xact_open(str(pid), synop, ext)
 
-		self.xact_dispatch(xact)
+		if xact is not None:
+			self.xact_dispatch(xact)
 		return xact
 
+	def _worker_exit(self, params, pid, delta):
+		# Delivered by the worker pool on the loop's thread.
+		self._requests.discard(pid)
+		self.process_exit(pid, delta, None, *params)
+
 	def xact_exit(self, xact):
 		# Subprocess Transaction
 		sp = xact.xact_context
@@ -527,14 +1730,24 @@ class Construction(kcore.Context):
 			self.process_exit(pid, status, None, *params)
 
 	def process_exit(self, pid, delta, rusage,
-			start_time, factor, log, cmd, tfile
+			start_time, lane, log, cmd, tfile, phase, stdout=None
 		):
 		ext = {}
+		factor = lane[0]
 		stop_time = self.time()
-		rusage = self._rusage.pop(pid, None)
-		self.progress[factor] += 1
-		self.process_count -= 1
-		self.activity.add(factor)
+		rusage = self._rusage.pop(pid, rusage)
+		self.progress[lane] += 1
+		self.process_pool.release(phase, self._reservations.pop(tfile, 0))
+		self.activity.add(lane)
+
+		if rusage is not None:
+			maxrss = int(rusage.ru_maxrss)
+			cputime = int((rusage.ru_stime + rusage.ru_utime) * (10**9))
+			self.process_pool.observe(factor.absolute_path_string, phase, rss(maxrss))
+		else:
+			# Worker requests; no usage of their own.
+			maxrss = 0
+			cputime = 0
 
 		exit_code = delta.status
 		if exit_code is None:
@@ -547,11 +1760,72 @@ class Construction(kcore.Context):
 		synopsis = str(factor.absolute_path_string) + ': '
 		synopsis += cmd + ' -> ' + str(exit_code)
 
-		# Force modification of directories for (persistent) cache checks.
-		if exit_code == 0:
-			if tfile.fs_type() == 'directory':
-				tfile.fs_modified()
-		else:
+		# Batched translations have an output and log per source.
+		outputs = list(self._batches.pop(tfile, None) or ((tfile, None),))
+
+		# The batch's diagnostics divided by the members' sources.
+		parts = {}
+		sources = self._diagnostics.pop(tfile, None)
+		if sources is not None:
+			try:
+				text = log.fs_load().decode('utf-8', 'surrogateescape')
+			except OSError:
+				text = ''
+			for (output, olog), part in zip(outputs, divide(text, sources)):
+				parts[output] = part
+
+		# Units of other variants reusing the translations.
+		for output, olog in list(outputs):
+			for copy, clog in self._shared.pop(output, ()):
+				if exit_code == 0:
+					self._reuse(output, olog or log, copy, clog)
+				outputs.append((copy, clog))
+				if output in parts:
+					parts[copy] = parts[output]
+
+		# Standard I/O files of the command.
+		self.c_status.invalidate(log)
+		if stdout is not None:
+			self.c_status.invalidate(stdout)
+
+		for output, olog in outputs:
+			# The target and its dependency file were (potentially) written;
+			# forget any recorded status.
+			self.c_status.invalidate(output)
+			dfile = self._dependency_file(olog or log)
+			self.c_status.invalidate(dfile)
+			if olog is not None:
+				self.c_status.invalidate(olog)
+			if self.c_prerequisites is not None and exit_code == 0:
+				self.c_prerequisites.update(map(str, dependencies(dfile)))
+
+			# Force modification of directories for (persistent) cache checks.
+			record = self._records.pop(output, None)
+			deposit = self._deposits.pop(output, None)
+			if exit_code == 0:
+				if output.fs_type() == 'directory':
+					output.fs_modified()
+
+				if record is not None:
+					# Digest of the inputs as they were processed.
+					dr, inputs, plan, depfile = record
+					dr.fs_store(digest(self._inputs(inputs, depfile), plan))
+
+				if deposit is not None:
+					# Keyed by the prerequisites the command reported.
+					self._deposit(output, *deposit)
+
+			if olog is not None:
+				# Per-unit view of the command's log.
+				try:
+					if output in parts:
+						olog.fs_store(parts[output].encode('utf-8', 'surrogateescape'))
+					else:
+						stage.place(log, olog)
+				except OSError:
+					pass
+
+		if exit_code != 0:
 			self.failures += 1
 
 		if exit_code is None:
@@ -562,18 +1836,37 @@ class Construction(kcore.Context):
 			work = metrics.Work(0, 1, 0, 0)
 		else:
 			exit_type = 'failed'
-			with log.fs_open('r') as f:
-				ext['@failure-image'] = ['system-command-error']
-				ext['@failure-image'].extend(f.read().split('\n'))
+			ext['@failure-image'] = ['system-command-error']
+			try:
+				ext['@failure-image'].extend(tail(log))
+			except OSError:
+				pass
 			work = metrics.Work(0, 0, 0, 1)
 
 		usage = metrics.Resource(
-			1, int(rusage.ru_maxrss),
+			1, maxrss,
 			# Nanosecond precision.
-			int((rusage.ru_stime + rusage.ru_utime) * (10**9)),
+			cputime,
 			stop_time - start_time,
 		)
 
+		variant, source = self._labels.pop(tfile, ('', ''))
+		if self.c_history is not None and exit_code == 0:
+			self.c_history.record((factor.absolute_path_string, phase, variant, source),
+				int(stop_time - start_time), rss(maxrss)
+			)
+
+		if self.c_trace is not None:
+			self.c_trace.operation(pid,
+				str(factor) + ': ' + tfile.identifier, phase,
+				int(start_time), int(stop_time),
+				factor=factor.absolute_path_string,
+				variant=variant,
+				cpu=cputime,
+				memory=rss(maxrss),
+				status=exit_code,
+			)
+
 		xact_metrics = metrics.Procedure(work=work, msg=metrics.Advisory(), usage=usage)
 		ext['@metrics'] = [xact_metrics.sequence()]
 		self.log.xact_close(str(pid), synopsis, ext)
@@ -583,6 +1876,27 @@ class Construction(kcore.Context):
 			self.continued = True
 			self.enqueue(self.continuation)
 
+	def _reuse(self, unit, log, copy, clog):
+		# Copy the &unit and dependency file translated by another variant.
+		# Dependency files are not linked as translations rewrite them in place.
+		for src, dst, linked in (
+			(unit, copy, True),
+			(self._dependency_file(log), self._dependency_file(clog), False),
+		):
+			try:
+				stage.place(src, dst, linked=linked)
+			except OSError:
+				pass
+
+	def process_signal(self):
+		"""
+		# Called by the &process_pool when a slot has been released
+		# by any of its members.
+		"""
+		if self.command_queue and self.continued is False:
+			self.continued = True
+			self.enqueue(self.continuation)
+
 	def drain_process_queue(self):
 		"""
 		# After process slots have been cleared by &process_exit,
@@ -590,24 +1904,43 @@ class Construction(kcore.Context):
 		# system processes enqueued in &command_queue.
 		"""
 		# Process slots may have been cleared, run more if possible.
-		nitems = len(self.command_queue)
-		if nitems > 0:
-			# Identify number of processes to spawn.
-			# &process_exit decrements the process_count, so the available
-			# logical slots are normally the selected count. Minimize
-			# on the number of items in the &command_queue.
-			pcount = min(self.process_limit - self.process_count, nitems)
-			for x in range(pcount):
-				cmd = self.command_queue.popleft()
-				try:
-					self.process_execute(cmd)
-				except Exception as error:
-					# Display exception and note progress.
-					import traceback
-					traceback.print_exception(error.__class__, error, error.__traceback__)
-					self.progress[cmd[0]] += 1
-				else:
-					self.process_count += 1
+		# &process_exit releases the slot, so the available
+		# logical slots are normally the selected count.
+		pool = self.process_pool
+		held = []
+		while self.command_queue and pool.available() > 0:
+			entry = heapq.heappop(self.command_queue)
+			cmd = entry[-1]
+			memory = pool.estimate(cmd[1][0].absolute_path_string, cmd[0])
+			if not pool.admits(cmd[0], memory):
+				# Phase or memory limit reached; retain position for the next drain.
+				held.append(entry)
+				continue
+
+			try:
+				self.process_execute(cmd)
+			except Exception as error:
+				# Display exception and note progress.
+				import traceback
+				traceback.print_exception(error.__class__, error, error.__traceback__)
+				self.progress[cmd[1]] += 1
+				self.activity.add(cmd[1])
+
+				if self.continued is False:
+					self.continued = True
+					self.enqueue(self.continuation)
+			else:
+				pool.acquire(cmd[0], memory)
+				self._reservations[cmd[2][1]] = memory
+
+		for entry in held:
+			heapq.heappush(self.command_queue, entry)
+
+		if self.c_trace is not None:
+			self.c_trace.counter('scheduler', int(self.time()),
+				queued=sum(len(x.command_queue) for x in pool.members),
+				running=pool.count,
+			)
 
 	def continuation(self):
 		"""
@@ -617,20 +1950,25 @@ class Construction(kcore.Context):
 		"""
 		# Reset continuation
 		self.continued = False
-		factors = list(self.activity)
+		lanes = list(self.activity)
 		self.activity.clear()
 
 		completions = set()
+		translated = False
 
-		for x in factors:
+		for x in lanes:
 			tracking = self.tracking[x]
 			if not tracking:
 				# Empty tracking sets.
 				completions.add(x)
 				continue
 
-			if self.progress[x] >= len(tracking[0][1]):
+			if self.progress[x] == -1:
+				# Held set of instructions.
+				self.attempt(x)
+			elif self.progress[x] >= len(tracking[0][1]):
 				# Pop action set.
+				translated = translated or tracking[0][0] == 'translate'
 				del tracking[0]
 				self.progress[x] = -1
 
@@ -639,30 +1977,87 @@ class Construction(kcore.Context):
 					completions.add(x)
 				else:
 					# dispatch new set of instructions.
-					self.dispatch(x)
+					self.attempt(x)
 			else:
 				# Nothing to be done; likely waiting on more
 				# process exits in order to complete the task set.
 				pass
 
-		if completions:
-			self.finish(completions)
+		if translated and self.held:
+			# Held renders may be awaiting the reused units.
+			self.activity.update(self.held)
+			self.held.clear()
+
+			if self.continued is False:
+				self.continued = True
+				self.enqueue(self.continuation)
+
+		factors = []
+		for lane in completions:
+			del self.tracking[lane]
+			del self.progress[lane]
+			self.awaiting.pop(lane, None)
+
+			factor = lane[0]
+			remainder = self.lanes.get(factor)
+			if remainder:
+				remainder.discard(lane)
+				if remainder:
+					continue
+				del self.lanes[factor]
+			factors.append(factor)
+
+		if factors:
+			self.finish(factors)
 
 		self.drain_process_queue()
 
-	def dispatch(self, factor):
+	def attempt(self, lane):
 		"""
-		# Process the collected work for the factor.
+		# Dispatch the next set of instructions for &lane unless it is a render
+		# waiting on the completion of pipelined requirements or on the
+		# preparation and translation of the units reused from other variants.
 		"""
-		assert self.progress[factor] == -1
-		self.progress[factor] = 0
+		if self.tracking[lane][0][0] == 'render':
+			if any(r in self.lanes for r in self.pending.get(lane[0], ())):
+				self.held.add(lane)
+				return
+
+			for x in self.awaiting.get(lane, ()):
+				tracks = self.tracking.get(x)
+				if tracks and tracks[0][0] != 'render':
+					# Preparing or translating the reused units.
+					self.held.add(lane)
+					return
+
+		self.dispatch(lane)
 
-		phase, commands = self.tracking[factor][0]
+	def dispatch(self, lane):
+		"""
+		# Process the collected work for the factor's variant identified by &lane.
+		"""
+		factor = lane[0]
+		assert self.progress[lane] == -1
+		self.progress[lane] = 0
+
+		phase, commands, condition = self.tracking[lane][0]
+		if commands and condition is not None and not condition():
+			# Early cutoff; the inputs did not change.
+			for x in commands:
+				self._records.pop(x[1], None)
+				self._deposits.pop(x[1], None)
+
+			commands = []
+			self.tracking[lane][0] = (phase, commands, None)
+			self.status('<cutoff>', factor, f"units unchanged, {phase} skipped", 1, 1)
+
+		priority = -self.priority.get(factor, 0)
 		for x in commands:
-			self.command_queue.append((phase, factor, x))
+			entry = (priority, next(self.command_order), (phase, lane, x))
+			heapq.heappush(self.command_queue, entry)
 
-		if self.progress[factor] >= len(self.tracking[factor][0][1]):
-			self.activity.add(factor)
+		if self.progress[lane] >= len(self.tracking[lane][0][1]):
+			self.activity.add(lane)
 
 			if self.continued is False:
 				self.continued = True
@@ -7,10 +7,26 @@ import functools
 import itertools
 import operator
 
-from fault.context import tools
 from fault.system import files
 from fault.project import system as lsf
 
+from . import memo
+
+# Factor types whose images are only needed by the render phase of their dependents.
+# When pipelining is enabled, dependents may be translated while these are processed.
+pipelined = {
+	'http://if.fault.io/factors/system.library',
+	'http://if.fault.io/factors/system.extension',
+}
+
+# Factor types and source languages that may be translated as amalgamated sources.
+unified = {
+	'http://if.fault.io/factors/system.executable',
+	'http://if.fault.io/factors/system.library',
+	'http://if.fault.io/factors/system.extension',
+}
+unified_languages = {'c', 'c++', 'objective-c', 'objective-c++'}
+
 class SystemFactor(object):
 	"""
 	# Target representing a system factor.
@@ -254,7 +270,7 @@ class Integrand(tuple):
 		return self.locations['factor-image']
 
 	@staticmethod
-	@tools.cachedcalls(8)
+	@memo.cached('references', 64, scale=4)
 	def _qrefs(rfactor, ri):
 		tr = lsf.types.Reference.from_ri('type', ri)
 
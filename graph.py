@@ -3,33 +3,99 @@
 
 # Used by &.cc to order the target factors according to their dependencies.
 """
+import itertools
 import collections
 
 def traverse(directory, working, tree, inverse, node):
 	"""
 	# Invert the directed graph of dependencies from the node.
+
+	# Performed iteratively; &directory is called once for each node
+	# not already present in &tree or &working.
 	"""
 
-	deps = set(directory(node))
+	stack = [node]
+	while stack:
+		node = stack.pop()
+		if node in tree or node in working:
+			# It's already been traversed in a previous run.
+			continue
+
+		deps = set(directory(node))
+
+		if not deps:
+			# No dependencies, add to working set.
+			working.add(node)
+			continue
+
+		# dependencies present, assign them inside the tree.
+		tree[node] = deps
+
+		for x in deps:
+			# Note the factor as depending on &x and build
+			# its tree.
+			inverse[x].add(node)
+			stack.append(x)
 
-	if not deps:
-		# No dependencies, add to working set and return.
-		working.add(node)
-		return
-	elif node in tree:
-		# It's already been traversed in a previous run.
-		return
+def _unit(node):
+	return 1
+
+def weigh(inverse, nodes, cost=_unit):
+	"""
+	# Weigh the &nodes by the cost of the longest chain of dependents
+	# identified by &inverse; the critical path through the node.
+
+	# [ Parameters ]
+	# /inverse/
+		# The mapping of nodes to the set of nodes depending on them.
+	# /nodes/
+		# The nodes to weigh.
+	# /cost/
+		# The function producing the cost of processing a node.
+		# Defaults to a uniform cost causing the weight to be
+		# the length of the longest chain.
+	"""
+	weights = {}
+	visiting = set()
+
+	for root in nodes:
+		stack = [(root, False)]
+		while stack:
+			node, expanded = stack.pop()
+			if node in weights:
+				continue
+
+			if expanded:
+				# Cycles are cut at the node being visited.
+				downstream = [weights.get(x, 0) for x in inverse.get(node, ())]
+				weights[node] = cost(node) + max(downstream, default=0)
+				visiting.discard(node)
+			else:
+				visiting.add(node)
+				stack.append((node, True))
+				for x in inverse.get(node, ()):
+					if x not in weights and x not in visiting:
+						stack.append((x, False))
+
+	return weights
+
+def affected(inverse, nodes):
+	"""
+	# Identify the &nodes and all the nodes transitively depending on them.
+	"""
+	selected = set()
+	stack = list(nodes)
+	while stack:
+		node = stack.pop()
+		if node in selected:
+			continue
 
-	# dependencies present, assign them inside the tree.
-	tree[node] = deps
+		selected.add(node)
+		stack.extend(inverse.get(node, ()))
 
-	for x in deps:
-		# Note the factor as depending on &x and build
-		# its tree.
-		inverse[x].add(node)
-		traverse(directory, working, tree, inverse, x)
+	return selected
 
-def sequence(directory, nodes, defaultdict=collections.defaultdict, tuple=tuple):
+def sequence(directory, nodes, cost=_unit, dirty=None, defaultdict=collections.defaultdict, tuple=tuple):
 	"""
 	# Generator maintaining the state of the sequencing of a traversed dependency
 	# graph. This generator emits factors as they are ready to be processed and receives
@@ -42,6 +108,14 @@ def sequence(directory, nodes, defaultdict=collections.defaultdict, tuple=tuple)
 	# Completion is an abstract notion, &sequence has no requirements on the semantics of
 	# completion and its effects; it merely communicates what can now be processed based
 	# completion state.
+
+	# Emitted nodes are ordered by their &weigh result, highest first, and the
+	# weights are included so that the caller may prioritize the work of
+	# nodes on the critical path. &cost is given to &weigh.
+
+	# When &dirty is not &None, only the nodes in &dirty and their dependents
+	# are emitted; all other nodes are considered complete. The emitted
+	# requirements remain complete.
 	"""
 
 	reqs = dict()
@@ -52,6 +126,9 @@ def sequence(directory, nodes, defaultdict=collections.defaultdict, tuple=tuple)
 	for node in nodes:
 		traverse(directory, working, tree, inverse, node)
 
+	weights = weigh(inverse, list(tree) + list(working), cost)
+	priority = (lambda x: weights[x])
+
 	new = working
 	# Copy tree.
 	for x, y in tree.items():
@@ -59,6 +136,21 @@ def sequence(directory, nodes, defaultdict=collections.defaultdict, tuple=tuple)
 		for f in y:
 			cs[f.type].add(f)
 
+	if dirty is not None:
+		selected = affected(inverse, [x for x in dirty if x in tree or x in working or x in inverse])
+
+		# Unaffected nodes are complete; release their dependents without emitting them.
+		for node in [x for x in itertools.chain(working, tree) if x not in selected]:
+			working.discard(node)
+			tree.pop(node, None)
+
+			for deps in inverse[node]:
+				if deps in tree:
+					tree[deps].discard(node)
+					if not tree[deps] and deps in selected:
+						working.add(deps)
+						del tree[deps]
+
 	yield None
 
 	while working:
@@ -66,7 +158,12 @@ def sequence(directory, nodes, defaultdict=collections.defaultdict, tuple=tuple)
 			if x not in reqs:
 				reqs[x] = defaultdict(set)
 
-		completion = (yield tuple(new), reqs, {x: tuple(inverse[x]) for x in new if inverse[x]})
+		completion = (yield (
+			tuple(sorted(new, key=priority, reverse=True)),
+			reqs,
+			{x: tuple(inverse[x]) for x in new if inverse[x]},
+			{x: weights[x] for x in new},
+		))
 		for x in new:
 			reqs.pop(x, None)
 		new = set() # &completion triggers new additions to &working
@@ -0,0 +1,133 @@
+"""
+# Persistent record of the durations and memory usage of previous builds.
+
+# &Record is loaded from and stored into an annotation of the build cache and
+# consulted for the critical path weights of &.graph.sequence, the memory
+# estimates of &.cc.Processors, and the remaining work reported during builds.
+"""
+import os
+import json
+import typing
+
+from fault.system import files
+
+# (factor path, phase, variant, source)
+Key = typing.Tuple[str, str, str, str]
+
+class Record(object):
+	"""
+	# Recent durations and the peak resident set size of operations
+	# identified by their factor, phase, variant, and source.
+
+	# [ Properties ]
+	# /depth/
+		# The number of durations retained for each operation.
+	# /operations/
+		# The recorded durations, in nanoseconds, and peak memory usage,
+		# in bytes, of the operations.
+	"""
+
+	def __init__(self, operations=None, depth=5):
+		self.depth = depth
+		self.operations = operations if operations is not None else {}
+		self._factors = None
+		self._mean = 0
+
+	@classmethod
+	def load(Class, route:files.Path, depth=5):
+		"""
+		# Load the record stored at &route; an empty record is returned
+		# when the file does not exist or cannot be interpreted.
+		"""
+		try:
+			data = json.loads(route.fs_load())
+			operations = {
+				tuple(key): (list(durations), int(memory))
+				for key, durations, memory in data['operations']
+			}
+		except (OSError, ValueError, KeyError, TypeError):
+			operations = {}
+
+		return Class(operations, depth=depth)
+
+	def store(self, route:files.Path):
+		"""
+		# Write the record to &route.
+
+		# The file is replaced atomically so that concurrent builds
+		# never observe a partial record.
+		"""
+		data = {
+			'operations': [
+				[list(key), durations, memory]
+				for key, (durations, memory) in self.operations.items()
+			]
+		}
+
+		tmp = route.container / ('.' + route.identifier + '.' + str(os.getpid()))
+		tmp.fs_alloc().fs_store(json.dumps(data, separators=(',', ':')).encode('utf-8'))
+		os.replace(str(tmp), str(route))
+
+	def record(self, key:Key, duration:int, memory:int):
+		"""
+		# Note the &duration and &memory of a completed operation.
+		"""
+		durations = self.operations.get(key, ([], 0))[0]
+		durations.append(int(duration))
+		del durations[:-self.depth]
+		self.operations[key] = (durations, memory)
+		self._factors = None
+
+	def duration(self, key:Key) -> typing.Optional[int]:
+		"""
+		# The mean of the recent durations of the operation; &None if unknown.
+		"""
+		try:
+			durations = self.operations[key][0]
+		except KeyError:
+			return None
+		return sum(durations) // len(durations)
+
+	def _aggregate(self):
+		if self._factors is None:
+			factors = self._factors = {}
+			for key, (durations, memory) in self.operations.items():
+				f = factors.setdefault(key[0], [0, {}])
+				f[0] += sum(durations) // len(durations)
+				phases = f[1]
+				phases[key[1]] = max(phases.get(key[1], 0), memory)
+
+			if factors:
+				self._mean = sum(x[0] for x in factors.values()) // len(factors)
+			else:
+				self._mean = 0
+		return self._factors
+
+	def factor(self, factor:str) -> typing.Optional[int]:
+		"""
+		# The expected duration of all the operations of &factor; &None if unknown.
+		"""
+		f = self._aggregate().get(factor)
+		if f is None:
+			return None
+		return f[0]
+
+	def memory(self) -> typing.Iterator[typing.Tuple[str, str, int]]:
+		"""
+		# The peak memory usage observed for the phases of each factor.
+		"""
+		for factor, (duration, phases) in self._aggregate().items():
+			for phase, memory in phases.items():
+				yield factor, phase, memory
+
+	def cost(self, factor:str, default=None) -> int:
+		"""
+		# The weight of the factor identified by the path &factor
+		# for &.graph.sequence in milliseconds.
+
+		# Factors without history are given the mean of those with history.
+		"""
+		d = self.factor(factor)
+		if d is None:
+			d = self._mean if default is None else default
+		return max(1, d // 1000000)
@@ -0,0 +1,174 @@
+"""
+# Bounded memory for the memoized queries of a construction.
+
+# The memo sites register a named &LRU so that their sizes may be configured
+# with &configure and their counters reported at the end of a build.
+"""
+import functools
+import collections
+import typing
+
+class LRU(collections.OrderedDict):
+	"""
+	# Mapping retaining the most recently used &size items.
+
+	# [ Properties ]
+	# /size/
+		# The maximum number of items or &None if unbounded.
+	# /hits/
+		# The number of successful lookups.
+	# /misses/
+		# The number of failed lookups.
+	# /evictions/
+		# The number of items removed to respect &size.
+	# /insertions/
+		# The number of items added.
+	"""
+
+	def __init__(self, size:typing.Optional[int]=None):
+		super().__init__()
+		self.size = size
+		self.hits = 0
+		self.misses = 0
+		self.evictions = 0
+		self.insertions = 0
+
+	def __reduce__(self):
+		# Serialized as a plain mapping; counters are process local.
+		# The storage's items; lookups would count as hits and reorder the entries.
+		return (dict, (list(collections.OrderedDict.items(self)),))
+
+	def __getitem__(self, key):
+		try:
+			v = super().__getitem__(key)
+		except KeyError:
+			self.misses += 1
+			raise
+
+		self.hits += 1
+		self.move_to_end(key)
+		return v
+
+	def __setitem__(self, key, value):
+		if key not in self:
+			self.insertions += 1
+		super().__setitem__(key, value)
+		self.move_to_end(key)
+
+		if self.size is not None:
+			while len(self) > self.size:
+				self.popitem(last=False)
+				self.evictions += 1
+
+	def resize(self, size:typing.Optional[int]):
+		"""
+		# Change the &size of the mapping evicting the least recently used items.
+		"""
+		self.size = size
+		if size is not None:
+			while len(self) > size:
+				self.popitem(last=False)
+				self.evictions += 1
+
+class Site(object):
+	"""
+	# A named memo site and the &LRU instances created for it.
+
+	# [ Properties ]
+	# /default/
+		# The size used when no override or graph size is available.
+	# /scale/
+		# The number of items per factor of the graph; zero if the
+		# site's size does not depend on the graph.
+	"""
+
+	def __init__(self, name, default, scale=0):
+		self.name = name
+		self.default = default
+		self.scale = scale
+		self.size = default
+		self.instances = []
+
+	def allocate(self) -> LRU:
+		m = LRU(self.size)
+		self.instances.append(m)
+		return m
+
+	def resize(self, size):
+		self.size = size
+		for m in self.instances:
+			m.resize(size)
+
+	def counters(self) -> typing.Tuple[int, int, int, int]:
+		"""
+		# The sums of the hits, misses, evictions, and current items of the instances.
+		"""
+		return (
+			sum(m.hits for m in self.instances),
+			sum(m.misses for m in self.instances),
+			sum(m.evictions for m in self.instances),
+			sum(len(m) for m in self.instances),
+		)
+
+sites = {}
+def site(name, default, scale=0) -> Site:
+	"""
+	# Retrieve or create the &Site identified by &name.
+	"""
+	if name not in sites:
+		sites[name] = Site(name, default, scale)
+	return sites[name]
+
+def cached(name, default, scale=0):
+	"""
+	# Memoize the function's results by its positional arguments in the &LRU of &name.
+	"""
+	def decorate(function):
+		m = site(name, default, scale).allocate()
+
+		@functools.wraps(function)
+		def call(*args):
+			try:
+				return m[args]
+			except KeyError:
+				r = m[args] = function(*args)
+				return r
+
+		call.memo = m
+		return call
+
+	return decorate
+
+def parse(spec:str) -> typing.Mapping[str, typing.Optional[int]]:
+	"""
+	# Interpret a size specification such as (id)`ftype=32,vectors=none`.
+	"""
+	sizes = {}
+	for field in spec.split(','):
+		field = field.strip()
+		if not field:
+			continue
+
+		name, size = field.split('=', 1)
+		size = size.strip()
+		sizes[name.strip()] = None if size.lower() == 'none' else int(size)
+	return sizes
+
+def configure(factors:int=0, sizes:typing.Mapping[str, typing.Optional[int]]={}):
+	"""
+	# Size the registered sites for a graph of &factors and apply the explicit &sizes.
+	"""
+	for name, s in sites.items():
+		if name in sizes:
+			s.resize(sizes[name])
+		elif s.scale and s.default is not None:
+			s.resize(max(s.default, s.scale * factors))
+
+def report():
+	"""
+	# Generate the counters of the sites that have been used.
+	"""
+	for name, s in sorted(sites.items()):
+		hits, misses, evictions, items = s.counters()
+		if hits or misses:
+			yield name, hits, misses, evictions, items
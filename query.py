@@ -101,6 +101,29 @@ def select(paths, possibilities, preferences):
 
 	return name, path
 
+def processors(overcommit:float=1.5) -> int:
+	"""
+	# Identify a suitable number of concurrent processes for the system using
+	# the number of available processors and the current load average.
+
+	# [ Parameters ]
+	# /overcommit/
+		# The multiplier applied to the processor count in order to
+		# compensate for processes waiting on I/O.
+	"""
+
+	try:
+		count = len(os.sched_getaffinity(0))
+	except AttributeError:
+		count = os.cpu_count() or 1
+
+	try:
+		load = os.getloadavg()[0]
+	except (AttributeError, OSError):
+		load = 0.0
+
+	return max(1, int((count * overcommit) - load))
+
 def sysctl(names, route=None):
 	"""
 	# Retrieve the system control variables using (system:executable)`sysctl`.
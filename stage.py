@@ -0,0 +1,157 @@
+"""
+# Placement of files by reference when the filesystem allows it.
+
+# &place clones the source's extents where reflinks are supported, falls back
+# to a hard link, and only copies the data as a last resort. Targets are always
+# replaced by rename so that readers never observe a partial file.
+
+# Hard links share the inode with the source; writers that truncate files in
+# place must &detach the path first so that the other names are not modified.
+"""
+import os
+import sys
+import stat
+import errno
+import shutil
+import tempfile
+
+# Linux ioctl(2) request cloning the extents of a file; _IOW(0x94, 9, int).
+FICLONE = 0x40049409
+
+# Errors indicating that the method is not available for the pair of files.
+unsupported = {
+	errno.EXDEV, errno.EPERM, errno.EINVAL, errno.ENOTTY,
+	errno.EOPNOTSUPP, errno.ENOSYS, errno.EMLINK, errno.EACCES,
+}
+
+def _clone_linux(source, target) -> bool:
+	import fcntl
+
+	sfd = os.open(source, os.O_RDONLY|os.O_CLOEXEC)
+	try:
+		dfd = os.open(target, os.O_WRONLY|os.O_CREAT|os.O_EXCL|os.O_CLOEXEC, 0o666)
+		try:
+			fcntl.ioctl(dfd, FICLONE, sfd)
+		except OSError as err:
+			if err.errno not in unsupported:
+				raise
+			cloned = False
+		else:
+			cloned = True
+		finally:
+			os.close(dfd)
+	finally:
+		os.close(sfd)
+
+	if not cloned:
+		os.unlink(target)
+	return cloned
+
+_clonefile = None
+def _clone_darwin(source, target) -> bool:
+	global _clonefile
+	if _clonefile is None:
+		import ctypes
+		libc = ctypes.CDLL(None, use_errno=True)
+		_clonefile = libc.clonefile
+		_clonefile.argtypes = (ctypes.c_char_p, ctypes.c_char_p, ctypes.c_uint32)
+
+	if _clonefile(os.fsencode(source), os.fsencode(target), 0) == 0:
+		return True
+
+	import ctypes
+	e = ctypes.get_errno()
+	if e in unsupported:
+		return False
+	raise OSError(e, os.strerror(e), source)
+
+def clone(source:str, target:str) -> bool:
+	"""
+	# Create &target sharing the extents of &source. &False if the
+	# filesystem or platform does not support reflinks.
+
+	# &target must not exist.
+	"""
+	if sys.platform.startswith('linux'):
+		return _clone_linux(source, target)
+	elif sys.platform == 'darwin':
+		return _clone_darwin(source, target)
+	return False
+
+def link(source:str, target:str) -> bool:
+	"""
+	# Create &target as a hard link to &source. &False if links
+	# cannot be made between the files' locations.
+	"""
+	try:
+		os.link(source, target)
+	except OSError as err:
+		if err.errno not in unsupported:
+			raise
+		return False
+	return True
+
+def place(source, target, linked=True) -> str:
+	"""
+	# Make the content of &source available at &target.
+
+	# Clones and copies are new files modified now; links share the inode,
+	# and the modification time, of &source.
+
+	# [ Parameters ]
+	# /source/
+		# The path to the regular file to place.
+	# /target/
+		# The path to create or replace.
+	# /linked/
+		# Whether the target may be a hard link to &source.
+
+	# [ Returns ]
+	# The method used: (id)`clone`, (id)`link`, or (id)`copy`.
+	"""
+	src = str(source)
+	dst = str(target)
+	container = os.path.dirname(dst)
+	os.makedirs(container, exist_ok=True)
+
+	# Private directory so that concurrent or interrupted placements
+	# of the same target do not collide.
+	tmpd = tempfile.mkdtemp(prefix='.stage.', dir=container)
+	tmp = os.path.join(tmpd, os.path.basename(dst))
+	try:
+		if clone(src, tmp):
+			method = 'clone'
+		elif linked and link(src, tmp):
+			method = 'link'
+		else:
+			shutil.copyfile(src, tmp)
+			method = 'copy'
+
+		if method != 'link':
+			shutil.copymode(src, tmp)
+			if method == 'clone':
+				# Not shared with &source; clonefile(2) retains the times.
+				os.utime(tmp)
+		os.replace(tmp, dst)
+	finally:
+		# Present when renamed onto an existing link to the same file.
+		if os.path.lexists(tmp):
+			os.unlink(tmp)
+		os.rmdir(tmpd)
+
+	return method
+
+def detach(path) -> bool:
+	"""
+	# Remove the regular file at &path if it has other names so that writing
+	# a new file at &path does not modify them. Returns whether it was removed.
+	"""
+	try:
+		st = os.lstat(str(path))
+	except FileNotFoundError:
+		return False
+
+	if stat.S_ISREG(st.st_mode) and st.st_nlink > 1:
+		os.unlink(str(path))
+		return True
+	return False
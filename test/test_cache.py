@@ -0,0 +1,82 @@
+"""
+# Build cache interface checks.
+"""
+import os
+from fault.system import files
+from .. import cache as module
+
+def test_select_stable(test):
+	"""
+	# Check that entries are consistent across instances.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+
+	for Class in (module.Directory, module.Persistent, module.Transient):
+		a = Class(tr).select('project', 'factor', b'key')
+		b = Class(tr).select('project', 'factor', b'key')
+		test/a == b
+		test/a != Class(tr).select('project', 'factor', b'other')
+		test/a != Class(tr).select('project', 'other', b'key')
+
+def test_budget(test):
+	test/module.budget('100') == 100
+	test/module.budget('2k') == 2048
+	test/module.budget('1.5M') == (3 << 19)
+
+def test_collect(test):
+	"""
+	# Check that the least recently selected entries are removed first.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	d = module.Transient(tr)
+
+	old = d.select('project', 'factor', b'old')
+	new = d.select('project', 'factor', b'new')
+	for x in (old, new):
+		(x/'unit').fs_alloc().fs_store(b'-' * 100)
+
+	os.utime(str(old), (0, 0))
+	test/d.collect(150) == (1, 100)
+	test/old.fs_type() == 'void'
+	test/new.fs_type() == 'directory'
+
+	# Within budget.
+	test/d.collect(150) == (0, 0)
+
+def test_http_unavailable(test):
+	"""
+	# Check that the store is disabled by a failure to connect.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'unit'
+	src.fs_store(b'data')
+
+	store = module.HTTPStore('http://127.0.0.1:1', timeout=2)
+	test/store.fetch_all([('k1', tr/'a'), ('k2', tr/'b')]) == set()
+	test/store.available == False
+	test/store.deposit('k1', src) == False
+	store.flush()
+
+def test_directory_store(test):
+	"""
+	# Check that fetched artifacts are new files more recent than the deposit.
+	"""
+	import os
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'unit'
+	src.fs_store(b'data')
+	os.utime(str(src), (1000, 1000))
+
+	store = module.DirectoryStore(tr/'store')
+	test/store.fetch('k1', tr/'fetched') == False
+	test/store.deposit('k1', src) == True
+	test/os.stat(str(src)).st_mtime == 1000
+
+	test/store.fetch('k1', tr/'fetched') == True
+	test/(tr/'fetched').fs_load() == b'data'
+	test/(os.stat(str(tr/'fetched')).st_mtime > 1000) == True
+	test/os.stat(str(tr/'fetched')).st_nlink == 1
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
@@ -1,8 +1,17 @@
 """
 # Construction Context tests.
 """
+import os
+import types
+import functools
+import collections
 from fault.system import files
+from fault.time import sysclock
 from .. import cc as module
+from .. import core
+from .. import cache
+from .. import graph
+from .. import history
 
 def test_updated(test):
 	tr = test.exits.enter_context(files.Path.fs_tmpdir())
@@ -22,6 +31,611 @@ def test_updated(test):
 	of.set_last_modified(sf.get_last_modified().elapse(second=10))
 	test/module.updated([of], [sf], None) == True
 
+def test_updated_status(test):
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+
+	of = tr / 'obj'
+	sf = tr / 'src'
+	status = cache.Status()
+
+	sf.fs_init()
+	test/module.updated([of], [sf], status=status) == False
+
+	# Memorized absence until invalidated.
+	of.fs_init()
+	of.set_last_modified(sf.get_last_modified().elapse(second=10))
+	test/module.updated([of], [sf], status=status) == False
+	status.invalidate(of)
+	test/module.updated([of], [sf], status=status) == True
+
+def test_dependencies(test):
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	df = tr / 'unit.d'
+
+	test/module.dependencies(df) == []
+
+	df.fs_store(b"\n".join([
+		b"/w/unit.o: /w/src/a.c /w/include/a.h \\",
+		b"  /w/include/with\\ space.h",
+		b"/w/include/a.h:",
+	]))
+	test/list(map(str, module.dependencies(df))) == [
+		'/w/src/a.c',
+		'/w/include/a.h',
+		'/w/include/with space.h',
+	]
+
+def test_identical(test):
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+
+	of = tr / 'obj'
+	sf = tr / 'src'
+	rf = tr / 'digest'
+	plan = ([], '/bin/cc', ['cc', '-c'])
+
+	sf.fs_store(b'source')
+	state = module.digest([sf], plan)
+	test/module.identical([of], rf, state) == False
+
+	# Output exists, but no record.
+	of.fs_init()
+	test/module.identical([of], rf, state) == False
+
+	rf.fs_store(state)
+	test/module.identical([of], rf, state) == True
+	test/module.identical([of], rf, state, never=True) == False
+
+	# Modification times are irrelevant.
+	of.set_last_modified(sf.get_last_modified().rollback(second=10))
+	test/module.identical([of], rf, state) == True
+
+	# Command and content changes are not.
+	test/module.identical([of], rf, module.digest([sf], ([], '/bin/cc', ['cc']))) == False
+	sf.fs_store(b'changed')
+	test/module.identical([of], rf, module.digest([sf], plan)) == False
+
+class Log(object):
+	# Transcript stub.
+	def __getattr__(self, name):
+		return (lambda *args, **kw: None)
+
+class Mechanism(object):
+	# Mechanism stub composing the queries of the Batch phase.
+	def batch(self, section, variants, itype, srctype):
+		def construct(q):
+			yield 'batch'
+			yield '-'
+			yield '-'
+			for x in ('sources', 'units', 'dependencies'):
+				yield from q(x)
+		return ([], '/bin/true', ['true']), construct
+
+Format = collections.namedtuple('Format', ('language', 'dialect'))
+SourceType = collections.namedtuple('SourceType', ('format', 'isolation'))
+Variants = collections.namedtuple('Variants', ('intention', 'system', 'architecture', 'form'))
+variants = Variants('optimal', 's', 'a', '')
+
+class Factor(object):
+	# Target stub with a single C source.
+	def __init__(self, route, source):
+		self.project = types.SimpleNamespace(factor='project')
+		self.route = 'f'
+		self.name = 'f'
+		self.type = 'type'
+		self.absolute_path_string = 'project.f'
+		self._route = route
+		self._sources = [(SourceType(Format('c', None), None), source)]
+
+	def sources(self):
+		return self._sources
+
+	def image(self, variants):
+		return self._route/'image'/'f'
+
+def construction(route):
+	return module.Construction(
+		None, sysclock.elapsed(), Log(),
+		['optimal'], '',
+		cache.Transient(route/'cache'), None, {}, None, [],
+		None, [],
+	)
+
+def batch(route):
+	cxn = construction(route)
+	factor = Factor(route, route/'src'/'a.c')
+	fmt = SourceType(Format('c', None), None)
+	fint = core.Integrand((None, factor, {}, {}, None, {}))
+
+	group = []
+	for x in ('a', 'b'):
+		src = route/'src'/(x + '.c')
+		src.fs_alloc().fs_store(b'')
+		unit = route/'units'/(x + '.c.o')
+		log = route/'log'/(x + '.c')
+		log.fs_alloc()
+		unit.fs_alloc()
+		group.append((src, unit, log, None))
+
+	ins = cxn._batch(Mechanism(), fint, None, None, fmt, group)
+	return cxn, factor, group, ins
+
+def test_batch(test):
+	"""
+	# Check that a batch is composed with the queries of each member.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, factor, group, ins = batch(tr)
+
+	settings, xpath, xargs = ins[5]
+	test/ins[1] == group[0][1]
+	test/ins[4] == tr/'log'/'a.c.batch'
+	test/xargs[1:] == [
+		str(tr/'src'/'a.c'), str(tr/'src'/'b.c'),
+		str(tr/'units'/'a.c.o'), str(tr/'units'/'b.c.o'),
+		str(tr/'log'/'a.c.d'), str(tr/'log'/'b.c.d'),
+	]
+	test/cxn._batches[ins[1]] == tuple((x[1], x[2]) for x in group)
+
+def test_batch_exit(test):
+	"""
+	# Check that the exit of a batch divides the batch log into each member's log.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, factor, group, ins = batch(tr)
+	ins[4].fs_store(''.join(
+		str(x[0]) + ':1:1: warning: diagnostics\n' for x in group
+	).encode('utf-8'))
+	for x in group:
+		x[1].fs_store(b'unit')
+
+	lane = (factor, 'key')
+	cxn.continued = True # No continuation outside of a kernel.
+	cxn.process_exit(1, types.SimpleNamespace(status=0), None,
+		cxn.time(), lane, ins[4], 'batch', ins[1], 'translate'
+	)
+
+	test/cxn.progress[lane] == 1
+	test/(ins[1] in cxn._batches) == False
+	for src, unit, log, _ in group:
+		test/log.fs_load() == (str(src) + ':1:1: warning: diagnostics\n').encode('utf-8')
+
+def test_divide(test):
+	"""
+	# Check that batch diagnostics are divided by the location prefixes.
+	"""
+	text = ''.join([
+		"cc: note: leading\n",
+		"In file included from /src/a.c:1:\n",
+		"/include/a.h:2:1: error: header\n",
+		"   2 | x\n",
+		"/src/b.c:3:1: warning: b\n",
+		"/src/a.c:4:1: warning: a\n",
+	])
+	a, b, c = module.divide(text, ['/src/a.c', '/src/b.c', '/src/c.c'])
+	test/a == ''.join([
+		"cc: note: leading\n",
+		"In file included from /src/a.c:1:\n",
+		"/include/a.h:2:1: error: header\n",
+		"   2 | x\n",
+		"/src/a.c:4:1: warning: a\n",
+	])
+	test/b == "cc: note: leading\n/src/b.c:3:1: warning: b\n"
+	test/c == "cc: note: leading\n"
+
+def test_deposit_dependencies(test):
+	"""
+	# Check that deposits are keyed by the dependency file written by the command.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn = construction(tr)
+	deposited = []
+	class Store(object):
+		def deposit(self, key, source):
+			deposited.append((key, source))
+
+	src = tr/'src'/'a.c'
+	header = tr/'include'/'a.h'
+	unit = tr/'units'/'a.c.o'
+	log = tr/'log'/'a.c'
+	for x in (src, header, unit, log):
+		x.fs_alloc().fs_store(b'')
+
+	plan = ([], '/bin/cc', ['cc'])
+	depfile = cxn._dependency_file(log)
+	cxn.c_store = Store()
+	cxn._deposits[unit] = ((src,), plan, depfile)
+
+	# Written by the translation; absent when the lookups were skipped.
+	depfile.fs_store((str(unit) + ': ' + str(src) + ' ' + str(header) + '\n').encode('utf-8'))
+
+	factor = Factor(tr, src)
+	cxn.continued = True
+	cxn.process_exit(1, types.SimpleNamespace(status=0), None,
+		cxn.time(), (factor, 'key'), log, 'cc', unit, 'translate'
+	)
+
+	key = module.digest((src, src, header), plan, relative=cxn.c_relative).decode('ascii')
+	mkey = module.digest((src,), plan, relative=cxn.c_relative).decode('ascii') + '.d'
+	stored = cxn._stored_dependencies(depfile)
+	test/deposited == [(key, unit), (mkey, stored)]
+
+def test_fetch_dependencies(test):
+	"""
+	# Check that hosts without a local dependency file retrieve the unit
+	# through the dependency file recorded by the depositing host.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	entries = {}
+	class Store(object):
+		available = True
+		def deposit(self, key, source):
+			entries[key] = source.fs_load()
+		def fetch_all(self, requests):
+			found = set()
+			for key, target in requests:
+				if key in entries:
+					target.fs_alloc().fs_store(entries[key])
+					found.add(target)
+			return found
+
+	src = tr/'src'/'a.c'
+	header = tr/'include'/'a.h'
+	plan = ([], '/bin/cc', ['cc'])
+	relative = ((str(tr/'host'), '<work>'),)
+	for x in (src, header):
+		x.fs_alloc().fs_store(b'content')
+
+	# Depositing host.
+	cxn = construction(tr)
+	cxn.c_store = Store()
+	cxn.c_relative = relative
+	unit = tr/'host'/'units'/'a.c.o'
+	log = tr/'host'/'log'/'a.c'
+	depfile = cxn._dependency_file(log)
+	unit.fs_alloc().fs_store(b'unit')
+	depfile.fs_alloc().fs_store((str(unit) + ': ' + str(src) + ' ' + str(header) + '\n').encode('utf-8'))
+	cxn._deposit(unit, (src,), plan, depfile)
+	test/len(entries) == 2
+	test/all(str(tr/'host') not in x.decode('utf-8') for x in entries.values())
+
+	# Host without prior translations.
+	cxn = construction(tr)
+	cxn.c_store = Store()
+	cxn.c_relative = relative
+	depfile.fs_void()
+	unit.fs_void()
+	test/cxn._fetch_all({unit: ((src,), plan, depfile)}) == {unit}
+	test/unit.fs_load() == b'unit'
+	test/module.dependencies(depfile) == [src, header]
+	test/cxn._deposits == {}
+
+	# Changed header; the unit is absent and noted for deposit.
+	header.fs_store(b'changed')
+	depfile.fs_void()
+	unit.fs_void()
+	test/cxn._fetch_all({unit: ((src,), plan, depfile)}) == set()
+	test/cxn._deposits[unit] == ((src,), plan, depfile)
+
+def test_reuse_dependencies(test):
+	"""
+	# Check that reused dependency files do not share the other variant's file.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn = construction(tr)
+	unit = tr/'a'/'units'/'a.c.o'
+	log = tr/'a'/'log'/'a.c'
+	copy = tr/'b'/'units'/'a.c.o'
+	clog = tr/'b'/'log'/'a.c'
+	unit.fs_alloc().fs_store(b'unit')
+	cxn._dependency_file(log).fs_alloc().fs_store(b'a.c.o: a.c\n')
+
+	cxn._reuse(unit, log, copy, clog)
+	test/copy.fs_load() == b'unit'
+	depfile = cxn._dependency_file(clog)
+	test/depfile.fs_load() == b'a.c.o: a.c\n'
+	test/os.stat(str(depfile)).st_ino != os.stat(str(cxn._dependency_file(log))).st_ino
+
+def test_processors_memory(test):
+	"""
+	# Check that admission respects the memory budget once a process is running.
+	"""
+	pool = module.Processors(4, memory=100)
+	pool.observe('factor', 'render', 80)
+
+	m = pool.estimate('factor', 'render')
+	test/m == 80
+	test/pool.estimate('other', 'render') == 80
+	test/pool.estimate('other', 'translate') == 0
+
+	# Always admitted when idle.
+	test/pool.admits('render', 200) == True
+	pool.acquire('render', m)
+	test/pool.admits('render', m) == False
+	test/pool.admits('translate', 10) == True
+	pool.release('render', m)
+	test/pool.reserved == 0
+
+	test/module.rss(2, platform='linux') == 2048
+	test/module.rss(2048, platform='darwin') == 2048
+
+def test_environment(test):
+	"""
+	# Check that environments are shared by identical command settings.
+	"""
+	settings = [('FPI_TEST_ENVIRONMENT', 'value')]
+	env = module.environment(settings)
+	test/env['FPI_TEST_ENVIRONMENT'] == 'value'
+	test/(module.environment(list(settings)) is env) == True
+	test/(module.environment([]) is env) == False
+
+def test_manifest(test):
+	"""
+	# Check the fields of remote execution manifests.
+	"""
+	import json
+	plan = ([('K', 'V')], '/bin/cc', ['cc', '-c'])
+	m = json.loads(module.manifest(plan, ['/src/a.c'], ['/units/a.o']))
+	test/m['environment'] == [['K', 'V']]
+	test/m['executable'] == '/bin/cc'
+	test/m['arguments'] == ['cc', '-c']
+	test/m['inputs'] == ['/src/a.c']
+	test/m['outputs'] == ['/units/a.o']
+
+def test_directories(test):
+	"""
+	# Check that the directories named by a command's arguments are shipped
+	# with remote translations and that system locations are not.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	inc = tr/'include'
+	inc.fs_mkdir()
+	src = tr/'a.c'
+	src.fs_store(b'')
+
+	args = ['cc', '-I' + str(inc), '-isystem', str(inc), '-I/usr/include', str(src), '-c']
+	test/list(module.directories(args)) == [str(inc), str(inc)]
+	test/list(module.directories(['-I', '/usr'])) == []
+
+def test_tail(test):
+	"""
+	# Check that only the end of large logs is read.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	log = tr/'log'
+	log.fs_store(b'first\nsecond\nthird')
+	test/module.tail(log) == ['first', 'second', 'third']
+	test/module.tail(log, limit=8) == ['[10 bytes truncated]', 'third']
+
+def test_statuses(test):
+	"""
+	# Check that reports are aggregated until the interval passes.
+	"""
+	written = []
+	class Log(object):
+		def xact_status(self, *args):
+			written.append(args)
+
+	now = [0]
+	s = module.Statuses(Log(), 1.0, clock=(lambda: now[0]))
+	s.report('<cached>', 2, 2)
+	s.report('<cached>', 3, 3)
+	test/written == []
+
+	now[0] = 2
+	s.report('<stored>', 1)
+	test/len(written) == 2
+	test/written[0] == ('<cached>', "2 factors: 5 processing instructions skipped", {'@metrics': ['%0+5-0/5']})
+	test/written[1][2] == {}
+
+def test_attempt_awaiting(test):
+	"""
+	# Check that renders reusing the units of other variants are held until
+	# the other lane's preparations and translations are complete.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn = construction(tr)
+	dispatched = []
+	cxn.dispatch = dispatched.append
+
+	lane = ('f', 'debug')
+	other = ('f', 'optimal')
+	cxn.tracking[lane] = [('render', [], None)]
+	cxn.awaiting[lane] = {other}
+
+	for phase in ('prepare', 'translate'):
+		cxn.tracking[other] = [(phase, [], None), ('render', [], None)]
+		cxn.attempt(lane)
+		test/dispatched == []
+		test/(lane in cxn.held) == True
+		cxn.held.clear()
+
+	cxn.tracking[other] = [('render', [], None)]
+	cxn.attempt(lane)
+	test/dispatched == [lane]
+
+class Preparations(object):
+	# Mechanism stub preparing &header for the translations of &language.
+	def __init__(self, header, language):
+		self.header = header
+		self.language = language
+
+	def _constructor(self, *queries):
+		def construct(q):
+			yield 'stub'
+			yield '-'
+			yield '-'
+			for x in queries:
+				yield from q(x)
+		return ([], '/bin/true', ['true']), construct
+
+	def variants(self, intentions, form=''):
+		return [(None, variants)]
+
+	def unit_name_delta(self, section, variants, itype):
+		return ('', '.o')
+
+	def preparation(self, section, variants, itype, srctype):
+		if srctype.format.language == self.language:
+			return ((str(self.header),), '.pch')
+		return None
+
+	def prepare(self, section, variants, itype, srctype):
+		return self._constructor('headers', 'prepared')
+
+	def translate(self, section, variants, itype, srctype):
+		return self._constructor('source', 'unit', 'prepared')
+
+	def render(self, section, variants, itype):
+		return self._constructor('units')
+
+def prepared(tr, language, remote=None, depends=(), name=None):
+	"""
+	# Collect a factor whose unit is newer than its source.
+	"""
+	cxn = construction(tr)
+	cxn.c_remote = remote
+	cxn.c_project = types.SimpleNamespace(factor='project')
+	cxn._filter = functools.partial(module.updated, status=cxn.c_status)
+	dispatched = []
+	cxn.dispatch = dispatched.append
+
+	header = tr/'include'/'h.h'
+	header.fs_alloc().fs_store(b'')
+	src = files.Path(tr/'f', ('a.c',))
+	src.fs_alloc().fs_store(b'')
+	src.set_last_modified(src.get_last_modified().rollback(second=10))
+	header.set_last_modified(src.get_last_modified())
+
+	factor = Factor(tr, src)
+	key = module.work(variants, factor.name)
+	unit = cxn.c_cache.select(factor.project.factor, factor.route, key)/'units'/'a.c.o'
+	unit.fs_alloc().fs_store(b'')
+
+	if depends:
+		# Prerequisites recorded by a previous translation.
+		depfile = unit.container.container/'log'/'a.c.d'
+		depfile.fs_alloc().fs_store((str(unit) + ': ' + ' '.join(map(str, depends))).encode('utf-8'))
+
+	cxn.collect(Preparations(name or header, language), factor, {})
+	lane, = dispatched
+	return cxn, cxn.tracking[lane], unit
+
+def test_preparation_stale(test):
+	"""
+	# Check that a stale prepared artifact forces the translations of its format
+	# and that the artifact is given to the translations with the prepared query.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, tracks, unit = prepared(tr, 'c')
+
+	test/[x[0] for x in tracks] == ['prepare', 'translate', 'render']
+	artifact = tracks[0][1][0][1]
+	test/artifact.identifier == 'Prepared.c.pch'
+
+	translation, = tracks[1][1]
+	test/str(translation[1]) == str(unit)
+	test/translation[5][2][-1] == str(artifact)
+
+def test_preparation_relative(test):
+	"""
+	# Check that relative headers that are not sources are interpreted
+	# relative to the factor's source directory.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, tracks, unit = prepared(tr, 'c', name='../include/h.h')
+
+	preparation, = tracks[0][1]
+	test/(str(tr/'include'/'h.h') in preparation[5][2]) == True
+
+def test_preparation_absent(test):
+	"""
+	# Check that factors without a Prepare phase skip current units
+	# and that the prepared query is empty.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, tracks, unit = prepared(tr, 'cpp')
+
+	test/[x[0] for x in tracks] == ['translate', 'render']
+	test/tracks[0][1] == []
+
+	fmt = SourceType(Format('c', None), None)
+	test/module.Construction._prepared({}, fmt) == []
+
+def test_dependencies_absent(test):
+	"""
+	# Check that a removed prerequisite listed by the dependency file
+	# makes the unit outdated.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	cxn, tracks, unit = prepared(tr, 'cpp', depends=[tr/'include'/'removed.h'])
+
+	test/[x[0] for x in tracks] == ['translate', 'render']
+	translation, = tracks[0][1]
+	test/str(translation[1]) == str(unit)
+
+def test_amalgamate(test):
+	"""
+	# Check that amalgamated sources are only written when their members change.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	a = tr/'a.c'
+	b = tr/'b.c'
+	u = tr/'unity'/'u.c'
+
+	test/module.amalgamate(u, [a, b]) == True
+	test/u.fs_load() == ('#include "%s"\n#include "%s"\n' % (a, b)).encode('utf-8')
+	test/module.amalgamate(u, [a, b]) == False
+	test/module.amalgamate(u, [a]) == True
+
+def test_history_costs(test):
+	"""
+	# Check that sequences weighted by the history accept system factors.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	record = history.Record()
+	record.record(('project.f', 'render', 'optimal', ''), 5000000, 0)
+
+	cxn = module.Construction(
+		None, sysclock.elapsed(), Log(),
+		['optimal'], '',
+		cache.Transient(tr/'cache'), None, {}, None, [],
+		None, [],
+		history=record,
+	)
+
+	f = Factor(tr, tr/'a.c')
+	s = core.SystemFactor('http://if.fault.io/factors/system.library', 'm')
+	edges = {f: [s]}
+	seq = graph.sequence((lambda x: edges.get(x, ())), [f], cost=cxn.c_costs)
+	test/next(seq) == None
+
+	work, reqs, deps, weights = seq.send(())
+	test/work == (s,)
+	test/weights == {s: 6}
+	test/module.weight(record, s) == 1
+	test/module.weight(record, f) == 5
+
+def test_manifest_system(test):
+	"""
+	# Check that system headers listed by dependency files are not shipped.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = files.Path(tr/'f', ('a.c',))
+	header = tr/'include'/'h.h'
+	depends = [src, header, '/usr/include/stdio.h']
+	cxn, tracks, unit = prepared(tr, 'c', remote=files.Path.from_path('/bin/false'), depends=depends)
+
+	translation, = tracks[1][1]
+	inputs, outputs = cxn._manifests[translation[1]]
+	test/('/usr/include/stdio.h' in inputs) == False
+	test/(str(src) in inputs) == True
+	test/(str(header) in inputs) == True
+
+	artifact = tracks[0][1][0][1]
+	inputs, outputs = cxn._manifests[artifact]
+	test/inputs == [str(header)]
+	test/module.transferred(['/usr/lib/libm.so', '/usr', str(src)]) == [str(src)]
+
 if __name__ == '__main__':
 	from fault.test import library as libtest; import sys
 	libtest.execute(sys.modules[__name__])
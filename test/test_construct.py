@@ -0,0 +1,31 @@
+"""
+# Application checks not requiring a construction context.
+"""
+import types
+from ..bin import construct as module
+
+class Target(object):
+	def __init__(self, *sources):
+		self._sources = [(None, x) for x in sources]
+
+	def sources(self):
+		return self._sources
+
+def test_affected(test):
+	"""
+	# Check that changes are mapped to the targets having the changed sources
+	# and that changes to other files select all factors.
+	"""
+	a = Target('/p/a.c', '/p/b.c')
+	b = Target('/p/c.c')
+	app = types.SimpleNamespace(cxn_targets={'p': (None, [a, b])})
+
+	affected = module.Application.cxn_affected
+	test/affected(app, {'/p/b.c'}) == {a}
+	test/affected(app, {'/p/a.c', '/p/c.c'}) == {a, b}
+	test/affected(app, {'/p/a.c', '/p/include/h.h'}) == None
+	test/affected(app, set()) == set()
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
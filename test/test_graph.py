@@ -1,13 +1,91 @@
 """
 # Factor dependency graph checks.
 """
-from fault.system import files
+import collections
+from .. import graph as module
+
+Node = collections.namedtuple('Node', ('name', 'type'))
+
+def fixture():
+	a, b, c, d = (Node(x, 'library') for x in 'abcd')
+	# c requires b, b and d require a.
+	edges = {c: [b], b: [a], d: [a]}
+	return (a, b, c, d), (lambda x: edges.get(x, ()))
+
+def test_weigh(test):
+	"""
+	# Check the critical path weights of a graph.
+	"""
+	(a, b, c, d), directory = fixture()
+	inverse = {a: {b, d}, b: {c}}
+
+	w = module.weigh(inverse, [a, b, c, d])
+	test/w == {a: 3, b: 2, c: 1, d: 1}
+
+	costs = {a: 1, b: 1, c: 1, d: 10}
+	w = module.weigh(inverse, [a], costs.__getitem__)
+	test/w[a] == 11
+
+	# Cycles are cut.
+	w = module.weigh({a: {b}, b: {a}}, [a])
+	test/w == {a: 2, b: 1}
 
 def test_sequence(test):
 	"""
 	# Check the sequencing of a traversed Sources graph.
 	"""
-	test.skip("not implemented")
+	(a, b, c, d), directory = fixture()
+	seq = module.sequence(directory, [c, d])
+	test/next(seq) == None
+
+	work, reqs, deps, weights = seq.send(())
+	test/work == (a,)
+	test/weights == {a: 3}
+	test/set(deps[a]) == {b, d}
+
+	# Longest path first.
+	work, reqs, deps, weights = seq.send(work)
+	test/work == (b, d)
+	test/dict(reqs[b]) == {'library': {a}}
+
+	work, reqs, deps, weights = seq.send((b,))
+	test/work == (c,)
+	test/StopIteration ^ (lambda: seq.send((c, d)))
+
+def test_sequence_dirty(test):
+	"""
+	# Check that only the dirty nodes and their dependents are emitted.
+	"""
+	(a, b, c, d), directory = fixture()
+	seq = module.sequence(directory, [c, d], dirty={b})
+	test/next(seq) == None
+
+	work, reqs, deps, weights = seq.send(())
+	test/work == (b,)
+	# Requirements are retained for the emitted nodes.
+	test/dict(reqs[b]) == {'library': {a}}
+
+	work, reqs, deps, weights = seq.send(work)
+	test/work == (c,)
+	test/StopIteration ^ (lambda: seq.send(work))
+
+	# Nothing dirty.
+	seq = module.sequence(directory, [c, d], dirty=set())
+	test/next(seq) == None
+	test/StopIteration ^ (lambda: seq.send(()))
+
+def test_traverse_depth(test):
+	"""
+	# Check that long chains do not approach the recursion limit.
+	"""
+	chain = [Node(i, 'library') for i in range(10000)]
+	edges = dict(zip(chain[1:], ([x] for x in chain)))
+
+	tree, inverse, working = {}, collections.defaultdict(set), set()
+	module.traverse((lambda x: edges.get(x, ())), working, tree, inverse, chain[-1])
+	test/working == {chain[0]}
+	test/len(tree) == len(chain) - 1
+	test/inverse[chain[0]] == {chain[1]}
 
 if __name__ == '__main__':
 	from fault.test import library as libtest; import sys
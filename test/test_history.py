@@ -0,0 +1,49 @@
+"""
+# Operation history checks.
+"""
+from fault.system import files
+from .. import history as module
+
+def test_record(test):
+	"""
+	# Check that only the recent durations are retained and aggregated by factor.
+	"""
+	r = module.Record(depth=2)
+	key = ('project/factor', 'translate', 'optimal', 'src/a.c')
+	for d in (10, 20, 40):
+		r.record(key, d, 100)
+
+	test/r.operations[key] == ([20, 40], 100)
+	test/r.duration(key) == 30
+
+	r.record(('project/factor', 'render', 'optimal', ''), 5, 300)
+	test/r.factor('project/factor') == 35
+	test/r.factor('project/other') == None
+	test/set(r.memory()) == {
+		('project/factor', 'translate', 100),
+		('project/factor', 'render', 300),
+	}
+
+def test_store(test):
+	"""
+	# Check that stored records are restored and that invalid files are ignored.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	r = module.Record()
+	key = ('project/factor', 'render', 'optimal', '')
+	r.record(key, 2000000, 300)
+	r.store(tr/'history')
+
+	test/module.Record.load(tr/'history').operations == r.operations
+	test/module.Record.load(tr/'void').operations == {}
+
+	(tr/'invalid').fs_store(b'[')
+	test/module.Record.load(tr/'invalid').operations == {}
+
+	# Unknown factors are weighted by the mean.
+	test/r.cost('project/factor') == 2
+	test/r.cost('project/other') == 2
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
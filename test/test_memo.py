@@ -0,0 +1,65 @@
+"""
+# Memo site checks.
+"""
+from .. import memo as module
+
+def test_lru(test):
+	"""
+	# Check that the least recently used items are evicted and counted.
+	"""
+	m = module.LRU(2)
+	m['a'] = 1
+	m['b'] = 2
+	test/m['a'] == 1
+	m['c'] = 3
+
+	test/list(m) == ['a', 'c']
+	test/KeyError ^ (lambda: m['b'])
+	test/(m.hits, m.misses, m.evictions, m.insertions) == (1, 1, 1, 3)
+
+	m.resize(1)
+	test/list(m) == ['c']
+	test/m.evictions == 2
+
+def test_configure(test):
+	"""
+	# Check graph derived and explicit sizes.
+	"""
+	s = module.site('test-scaled', 8, scale=2)
+	m = s.allocate()
+	module.configure(100)
+	test/m.size == 200
+
+	module.configure(100, {'test-scaled': None})
+	test/m.size == None
+
+	test/module.parse('a=3, b=none') == {'a': 3, 'b': None}
+
+def test_cached(test):
+	calls = []
+	@module.cached('test-cached', 4)
+	def f(x):
+		calls.append(x)
+		return x * 2
+
+	test/f(2) == 4
+	test/f(2) == 4
+	test/calls == [2]
+	test/(f.memo.hits, f.memo.misses) == (1, 1)
+
+def test_pickle(test):
+	"""
+	# Check that serialization does not count as lookups.
+	"""
+	import pickle
+	m = module.LRU(8)
+	for i in range(5):
+		m[i] = i * 2
+
+	test/pickle.loads(pickle.dumps(m)) == {i: i * 2 for i in range(5)}
+	test/(m.hits, m.misses) == (0, 0)
+	test/list(m) == list(range(5))
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
@@ -0,0 +1,86 @@
+"""
+# Check the placement methods of the staging functions.
+"""
+import os
+from fault.system import files
+from .. import stage as module
+
+def test_place(test):
+	"""
+	# Check that the content is placed and that unlinked placement copies.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'src'
+	src.fs_store(b'data')
+
+	method = module.place(src, tr/'dst'/'linked')
+	test/(method in {'clone', 'link'}) == True
+	test/(tr/'dst'/'linked').fs_load() == b'data'
+
+	method = module.place(src, tr/'dst'/'copied', linked=False)
+	test/(method in {'clone', 'copy'}) == True
+	test/os.stat(str(tr/'dst'/'copied')).st_nlink == 1
+
+	# Replaced, not written through.
+	(tr/'dst'/'copied').fs_store(b'other')
+	module.place(src, tr/'dst'/'copied')
+	test/(tr/'dst'/'copied').fs_load() == b'data'
+	test/sorted(os.listdir(str(tr/'dst'))) == ['copied', 'linked']
+
+def test_place_times(test):
+	"""
+	# Check that links retain the source's modification time and that
+	# other methods create files modified now.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'src'
+	src.fs_store(b'data')
+	os.utime(str(src), (1000, 1000))
+
+	method = module.place(src, tr/'linked')
+	test/os.stat(str(src)).st_mtime == 1000
+	if method == 'link':
+		test/os.stat(str(tr/'linked')).st_mtime == 1000
+
+	module.place(src, tr/'copied', linked=False)
+	test/(os.stat(str(tr/'copied')).st_mtime > 1000) == True
+	test/os.stat(str(src)).st_mtime == 1000
+
+def test_place_interrupted(test):
+	"""
+	# Check that the remains of an interrupted placement do not prevent
+	# placing the same target again.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'src'
+	src.fs_store(b'data')
+	dst = tr/'dst'/'target'
+
+	module.place(src, dst)
+	remains = sorted(os.listdir(str(tr/'dst')))
+	test/remains == ['target']
+
+	(tr/'dst'/'target.stage').fs_store(b'stale')
+	(tr/'dst'/'.stage.x').fs_mkdir()
+	module.place(src, dst, linked=False)
+	test/dst.fs_load() == b'data'
+	test/sorted(os.listdir(str(tr/'dst'))) == ['.stage.x', 'target', 'target.stage']
+
+def test_detach(test):
+	"""
+	# Check that only files with other names are removed.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	src = tr/'src'
+	src.fs_store(b'data')
+	test/module.detach(src) == False
+
+	os.link(str(src), str(tr/'other'))
+	test/module.detach(tr/'other') == True
+	test/os.path.exists(str(tr/'other')) == False
+	test/src.fs_load() == b'data'
+	test/module.detach(tr/'absent') == False
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
@@ -0,0 +1,42 @@
+"""
+# Trace-event record checks.
+"""
+import json
+from fault.system import files
+from .. import trace as module
+
+def test_slots(test):
+	"""
+	# Check that concurrent operations occupy distinct slots and released
+	# slots are reused.
+	"""
+	r = module.Record()
+	test/r.start('a') == 0
+	test/r.start('b') == 1
+	r.operation('a', 'a', 'translate', 0, 1000)
+	test/r.start('c') == 0
+
+	event = r.events[0]
+	test/event['tid'] == 0
+	test/event['ts'] == 0
+	test/event['dur'] == 1
+
+def test_store(test):
+	"""
+	# Check that the stored document contains the events and slot names.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	r = module.Record()
+	r.start(1)
+	r.operation(1, 'factor', 'render', 2000, 5000, status=0)
+	r.counter('scheduler', 5000, queued=0, running=0)
+	r.store(tr/'trace.json')
+
+	doc = json.loads((tr/'trace.json').fs_load())
+	phases = [x['ph'] for x in doc['traceEvents']]
+	test/phases == ['M', 'X', 'C']
+	test/doc['traceEvents'][1]['args']['status'] == 0
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
@@ -0,0 +1,57 @@
+"""
+# Construction context descriptor checks.
+"""
+from .. import vectorcontext as module
+
+class Context(object):
+	# Context stub providing the merged vectors of the Prepare phase.
+	def __init__(self, index):
+		self.index = index
+		self.reads = 0
+
+	def _conclusions(self, *args):
+		return set()
+
+	def _constants(self, *args):
+		return {}
+
+	def _read_merged(self, vctx, section, variants, phase, itype, xtype):
+		self.reads += 1
+		if self.index is None:
+			raise KeyError(phase)
+		return '/bin/cc', 'adapter', self.index
+
+	def _cat(self, vctx, idx, name):
+		return iter(idx[name])
+
+	cc_preparation = module.Context.cc_preparation
+
+def test_preparation(test):
+	"""
+	# Check the interpretation of the (id)`[prepare-headers]` and
+	# (id)`[prepare-suffix]` vectors.
+	"""
+	p = Context({'[prepare-headers]': ['include/h.h', '/usr/include/stdio.h']})
+	test/p.cc_preparation(None, None, 'type', 'c') == (('include/h.h', '/usr/include/stdio.h'), '.pch')
+
+	p = Context({'[prepare-headers]': ['h.h'], '[prepare-suffix]': ['.gch']})
+	test/p.cc_preparation(None, None, 'type', 'c') == (('h.h',), '.gch')
+
+	# No Prepare phase, no headers vector, or an empty headers vector.
+	test/Context(None).cc_preparation(None, None, 'type', 'c') == None
+	test/Context({}).cc_preparation(None, None, 'type', 'c') == None
+	test/Context({'[prepare-headers]': []}).cc_preparation(None, None, 'type', 'c') == None
+
+def test_mechanism_preparation(test):
+	"""
+	# Check that the preparation of a source type is read once.
+	"""
+	p = Context({'[prepare-headers]': ['h.h']})
+	m = module.Mechanism(p, 'semantics')
+	test/m.preparation(None, None, 'type', 'c') == (('h.h',), '.pch')
+	test/m.preparation(None, None, 'type', 'c') == (('h.h',), '.pch')
+	test/p.reads == 1
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
@@ -0,0 +1,27 @@
+"""
+# Change detection checks.
+"""
+from fault.system import files
+from .. import watch as module
+
+def test_polling_update(test):
+	"""
+	# Check that paths added after construction are reported.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	a = tr/'a.c'
+	h = tr/'include'/'h.h'
+	a.fs_store(b'')
+	h.fs_alloc().fs_store(b'')
+
+	w = module.Polling([str(a)], interval=0.01)
+	test/w.wait(0) == set()
+
+	w.update([str(a), str(h)])
+	test/w.wait(0) == set()
+	h.fs_store(b'#define X\n')
+	test/w.wait(1) == {str(h)}
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
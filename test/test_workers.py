@@ -0,0 +1,80 @@
+"""
+# Persistent worker protocol checks.
+"""
+import os
+import sys
+import threading
+from fault.system import files
+from .. import workers as module
+
+# Writes the arguments to the stdout path and exits with the number of arguments.
+echo = """
+import sys, json
+for line in sys.stdin:
+	r = json.loads(line)
+	with open(r['stdout'], 'w') as f:
+		f.write(' '.join(r['arguments']))
+	print(json.dumps({'id': r['id'], 'status': len(r['arguments'])}), flush=True)
+"""
+
+def test_pool(test):
+	"""
+	# Check that requests are performed by a reused worker.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	pool = module.Pool(lambda settings: dict(os.environ))
+	template = (sys.executable, ('python', '-c', echo), ())
+
+	exits = []
+	done = threading.Event()
+	def complete(ident, exit):
+		exits.append((ident, exit.status))
+		done.set()
+
+	try:
+		for args in (['a'], ['b', 'c']):
+			done.clear()
+			r = module.Request(template, args)
+			ident = pool.submit(r, os.devnull, tr/'out', tr/'err', complete)
+			test/done.wait(10) == True
+			test/exits[-1] == (ident, len(args))
+
+		test/(tr/'out').fs_load() == b'b c'
+		test/len(pool.workers) == 1
+	finally:
+		pool.terminate()
+
+def test_pool_wake(test):
+	"""
+	# Check that completions wait for the delivery scheduled by the wake callable.
+	"""
+	tr = test.exits.enter_context(files.Path.fs_tmpdir())
+	woken = []
+	ready = threading.Event()
+	def wake(deliver):
+		woken.append(deliver)
+		ready.set()
+
+	pool = module.Pool(lambda settings: dict(os.environ), wake=wake)
+	template = (sys.executable, ('python', '-c', echo), ())
+	exits = []
+
+	try:
+		r = module.Request(template, ['a'])
+		ident = pool.submit(r, os.devnull, tr/'out', tr/'err',
+			lambda i, x: exits.append((i, x.status, threading.get_ident()))
+		)
+		test/ready.wait(10) == True
+		test/exits == []
+		test/len(woken) == 1
+		test/pool.idle[template] == []
+
+		woken[0]()
+		test/exits == [(ident, 1, threading.get_ident())]
+		test/len(pool.idle[template]) == 1
+	finally:
+		pool.terminate()
+
+if __name__ == '__main__':
+	from fault.test import library as libtest; import sys
+	libtest.execute(sys.modules[__name__])
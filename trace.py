@@ -0,0 +1,115 @@
+"""
+# Build trace recording for inspection with trace-event viewers.
+
+# &Record accumulates an event for each operation performed by the Constructions
+# of a run along with counters describing the scheduler's state. The collected
+# events are written as a Chrome trace-event JSON document by &Record.store.
+"""
+import json
+import typing
+
+from fault.system import files
+
+def _microseconds(ns:int) -> float:
+	return ns / 1000
+
+class Record(object):
+	"""
+	# Trace events of a construction run.
+
+	# Operations are assigned the lowest unoccupied slot when they are started so
+	# that the threads of the trace represent the process slots of the pool.
+	# Timestamps are nanosecond offsets from the start of the run.
+	"""
+
+	def __init__(self, pid=1):
+		self.pid = pid
+		self.events = []
+		self.slots = [] # Occupation state of each slot.
+		self.active = {} # operation key -> slot
+
+	def start(self, key) -> int:
+		"""
+		# Note the start of the operation identified by &key and return its slot.
+		"""
+		try:
+			slot = self.slots.index(False)
+		except ValueError:
+			slot = len(self.slots)
+			self.slots.append(False)
+
+		self.slots[slot] = True
+		self.active[key] = slot
+		return slot
+
+	def operation(self, key, name:str, category:str, start:int, stop:int, **args):
+		"""
+		# Record the completion of the operation identified by &key.
+
+		# [ Parameters ]
+		# /name/
+			# The label of the event; normally the factor and target.
+		# /category/
+			# The phase of the operation.
+		# /start/
+			# Nanosecond offset of the operation's start.
+		# /stop/
+			# Nanosecond offset of the operation's completion.
+		# /args/
+			# Additional fields displayed with the event.
+		"""
+		slot = self.active.pop(key, None)
+		if slot is None:
+			slot = self.start(key)
+			self.active.pop(key)
+		self.slots[slot] = False
+
+		self.events.append({
+			'ph': 'X',
+			'name': name,
+			'cat': category,
+			'pid': self.pid,
+			'tid': slot,
+			'ts': _microseconds(start),
+			'dur': _microseconds(stop - start),
+			'args': args,
+		})
+
+	def counter(self, name:str, time:int, **values):
+		"""
+		# Record the state of the counters identified by &name at &time.
+		"""
+		self.events.append({
+			'ph': 'C',
+			'name': name,
+			'pid': self.pid,
+			'ts': _microseconds(time),
+			'args': values,
+		})
+
+	def document(self) -> typing.Mapping:
+		"""
+		# Construct the trace-event document.
+		"""
+		meta = [
+			{
+				'ph': 'M',
+				'name': 'thread_name',
+				'pid': self.pid,
+				'tid': i,
+				'args': {'name': 'slot ' + str(i)},
+			}
+			for i in range(len(self.slots))
+		]
+
+		return {
+			'traceEvents': meta + self.events,
+			'displayTimeUnit': 'ms',
+		}
+
+	def store(self, route:files.Path):
+		"""
+		# Write the trace-event document to &route.
+		"""
+		data = json.dumps(self.document(), separators=(',', ':'))
+		route.fs_alloc().fs_store(data.encode('utf-8'))
@@ -1,7 +1,10 @@
 """
 # Construction Context implementation using vector formulations.
 """
+import os
 import sys
+import pickle
+import hashlib
 import functools
 import itertools
 import typing
@@ -13,6 +16,7 @@ from fault.project import system as lsf
 from fault.vector import formulation as vf
 
 from . import core
+from . import memo
 
 def _variant_constants(variants):
 	return {
@@ -39,19 +43,18 @@ class Mechanism(object):
 	def __init__(self, context, semantics):
 		self.context = context
 		self.semantics = semantics
-		self._cache = {}
+		self._cache = memo.site('mechanisms', None).allocate()
 
 	def __repr__(self):
 		return repr((self.context.route, self.semantics))
 
 	def _cc(self, phase, section, variants, itype, xtype):
 		k = (phase, section, variants, itype, xtype)
-		if k in self._cache:
+		try:
 			return self._cache[k]
-
-		c = self.context.cc_compose(phase, section, variants, itype, xtype)
-		self._cache[k] = c
-		return c
+		except KeyError:
+			c = self._cache[k] = self.context.cc_compose(phase, section, variants, itype, xtype)
+			return c
 
 	def variants(self, intentions, form=''):
 		"""
@@ -72,6 +75,19 @@ class Mechanism(object):
 		"""
 		return self._cc('Prepare', section, variants, itype, srctype)
 
+	def preparation(self, section, variants, itype, srctype) -> typing.Optional[typing.Tuple[typing.Sequence[str], str]]:
+		"""
+		# Identify the headers prepared for the translations of &srctype and the
+		# suffix of the prepared artifact. &None if the context does not declare
+		# a Prepare phase with (id)`[prepare-headers]` for the source type.
+		"""
+		k = ('Preparation', section, variants, itype, srctype)
+		try:
+			return self._cache[k]
+		except KeyError:
+			r = self._cache[k] = self.context.cc_preparation(section, variants, itype, srctype)
+			return r
+
 	def translate(self, section, variants, itype, srctype):
 		"""
 		# Construct the command constructor for translating sources.
@@ -84,6 +100,37 @@ class Mechanism(object):
 		"""
 		return self._cc('Render', section, variants, itype, None)
 
+	def batch(self, section, variants, itype, srctype):
+		"""
+		# Construct the command constructor for translating multiple sources
+		# with a single command.
+		"""
+		return self._cc('Batch', section, variants, itype, srctype)
+
+	def batch_limit(self, section, variants, itype, srctype) -> int:
+		"""
+		# Identify the maximum number of sources that a &batch command may be given.
+		# Zero if the context does not support batched translations.
+		"""
+		k = ('Batch-limit', section, variants, itype, srctype)
+		try:
+			return self._cache[k]
+		except KeyError:
+			r = self._cache[k] = self.context.cc_batch_limit(section, variants, itype, srctype)
+			return r
+
+	def worker(self, section, variants, itype, srctype) -> typing.Optional[typing.Sequence[str]]:
+		"""
+		# Identify the arguments that start the translation command as a persistent worker.
+		# &None if the context does not declare a worker mode.
+		"""
+		k = ('Worker', section, variants, itype, srctype)
+		try:
+			return self._cache[k]
+		except KeyError:
+			r = self._cache[k] = self.context.cc_worker(section, variants, itype, srctype)
+			return r
+
 class Context(object):
 	"""
 	# Vectors Composition based Mechanism set.
@@ -104,14 +151,16 @@ class Context(object):
 		return ref
 
 	@classmethod
-	def from_directory(Class, route:files.Path, intention:str='optimal'):
+	def from_directory(Class, route:files.Path, intention:str='optimal', compiled=None):
 		"""
 		# Create instance using a directory. Defaults depending intention to (id)`optimal`.
 		"""
-		return Class(route, intention)
+		return Class(route, intention, compiled=compiled)
 
-	def __init__(self, route:files.Path, intention:str):
+	def __init__(self, route:files.Path, intention:str, compiled:files.Path=None):
 		self.route = route
+		# Directory holding the parsed forms of vectors; shared across processes.
+		self.compiled = compiled
 		# Requirement intention for metadata contexts.
 		self.intention = intention
 		self.projects = lsf.Context()
@@ -119,23 +168,37 @@ class Context(object):
 		# Projection mappings. semantics -> project
 		self._idefault = None
 		self._icache = {}
-		self._vcache = {}
+		self._vcache = memo.site('vectors', None).allocate()
+		self._scache = {}
+
+		self._loaded = False
+		self._identity = None
+		self._restored = None
+
+		# Compositions depending only on the section, variants, and types.
+		self._host = None
+		self._ccache = {} # (section, variants, itype, xtype) -> (conclusions, constants)
+		self._dcache = {} # (section, variants, itype) -> unit name delta
 
 		# Initialization Context for loading projections and variants.
 		self._vinit = vf.Context(set(), {})
 
 	def _forms(self, factor):
-		return self._cat(self._vinit, self._load_vector(factor), '[forms]')
+		return self._cat(self._vinit, self._v(factor), '[forms]')
 
 	def _variants(self, factor):
 		# Read the full set of system-architecture pairs from a variants factor.
-		v = self._load_vector(factor)
+		v = self._v(factor)
 		for system in self._cat(self._vinit, v, '[systems]'):
 			for arch in self._cat(self._vinit, v, '[' + system + ']'):
 				yield (system, arch)
 
 	def cc_unit_name_delta(self, section, variants, itype):
 		# Unit name adjustments.
+		k = (section, variants, itype)
+		if k in self._dcache:
+			return self._dcache[k]
+
 		initctx = vf.Context(_variant_conclusions(variants), _variant_constants(variants))
 		exe, adapter, idx = self._read_merged(
 			initctx,
@@ -153,7 +216,64 @@ class Context(object):
 		except KeyError:
 			unit_suffix = ""
 
-		return unit_prefix, unit_suffix
+		delta = self._dcache[k] = (unit_prefix, unit_suffix)
+		return delta
+
+	def cc_batch_limit(self, section, variants, itype, xtype):
+		# Number of sources accepted by the Batch phase's command.
+		vctx = vf.Context(
+			self._conclusions(section, variants, itype, xtype),
+			self._constants(section, variants, itype, xtype)
+		)
+
+		try:
+			exe, adapter, idx = self._read_merged(vctx, section, variants, 'Batch', itype, xtype)
+			limit = list(self._cat(vctx, idx, "[batch-limit]"))[0]
+		except (KeyError, IndexError):
+			# No batch descriptor or no limit.
+			return 0
+
+		return int(limit)
+
+	def cc_worker(self, section, variants, itype, xtype):
+		# Worker mode arguments of the Translate phase's command.
+		vctx = vf.Context(
+			self._conclusions(section, variants, itype, xtype),
+			self._constants(section, variants, itype, xtype)
+		)
+
+		try:
+			exe, adapter, idx = self._read_merged(vctx, section, variants, 'Translate', itype, xtype)
+			if "[worker]" not in idx:
+				return None
+			return tuple(self._cat(vctx, idx, "[worker]"))
+		except KeyError:
+			return None
+
+	def cc_preparation(self, section, variants, itype, xtype):
+		# Headers and artifact suffix of the Prepare phase's command.
+		vctx = vf.Context(
+			self._conclusions(section, variants, itype, xtype),
+			self._constants(section, variants, itype, xtype)
+		)
+
+		try:
+			exe, adapter, idx = self._read_merged(vctx, section, variants, 'Prepare', itype, xtype)
+			if "[prepare-headers]" not in idx:
+				return None
+			headers = tuple(self._cat(vctx, idx, "[prepare-headers]"))
+		except KeyError:
+			return None
+
+		if not headers:
+			return None
+
+		try:
+			suffix = list(self._cat(vctx, idx, "[prepare-suffix]"))[0]
+		except (KeyError, IndexError):
+			suffix = ".pch"
+
+		return headers, suffix
 
 	def cc_variants(self, semantics, intentions, form=''):
 		"""
@@ -181,7 +301,38 @@ class Context(object):
 
 		return fvp
 
+	def host(self):
+		"""
+		# The system, architecture, and Python identifiers of the host. Queried once.
+		"""
+		if self._host is None:
+			from fault.system import identity
+			system, architecture = identity.root_execution_context()
+			self._host = (system, architecture, identity.python_execution_context()[1])
+
+		return self._host
+
+	def _composition(self, section, variants, itype, xtype):
+		# Conclusions and constants shared by the compositions of the same parameters.
+		k = (section, variants, itype, xtype)
+		if k not in self._ccache:
+			self._ccache[k] = (
+				frozenset(self._select_conclusions(section, variants, itype, xtype)),
+				self._select_constants(section, variants, itype, xtype),
+			)
+		return self._ccache[k]
+
 	def _constants(self, section, variants, itype, xtype, **kw):
+		# Copied as the composition context may be modified.
+		constants = dict(self._composition(section, variants, itype, xtype)[1])
+		constants.update(kw)
+		return constants
+
+	def _conclusions(self, section, variants, itype, xtype):
+		return set(self._composition(section, variants, itype, xtype)[0])
+
+	def _select_constants(self, section, variants, itype, xtype):
+		kw = {}
 		if xtype:
 			fmt = xtype.format
 			kw.update({'language': fmt.language, 'dialect': fmt.dialect})
@@ -189,14 +340,11 @@ class Context(object):
 		kw['null'] = '/dev/null'
 		kw['factor-integration-type'] = str(itype.factor)
 		kw.update(_variant_constants(variants))
-
-		from fault.system import identity
-		kw['host-system'], kw['host-architecture'] = identity.root_execution_context()
-		kw['host-python'] = identity.python_execution_context()[1]
+		kw['host-system'], kw['host-architecture'], kw['host-python'] = self.host()
 
 		return kw
 
-	def _conclusions(self, section, variants, itype, xtype):
+	def _select_conclusions(self, section, variants, itype, xtype):
 		if xtype and xtype.isolation:
 			fmt = xtype.format
 			l = {'language-' + fmt.language, 'dialect-' + (fmt.dialect or '')}
@@ -229,7 +377,9 @@ class Context(object):
 		else:
 			prefix = ('type',)
 
-		if k not in self._vcache:
+		try:
+			return self._vcache[k]
+		except KeyError:
 			fall = phase
 			if xtype:
 				name = phase + '-' + xtype.isolation.split('.', 1)[0]
@@ -238,9 +388,8 @@ class Context(object):
 				if itype.isolation:
 					name += '-' + itype.isolation
 
-			self._vcache[k] = list(self._compose(vctx, section, prefix, itype, name, fall))
-
-		return self._vcache[k]
+			r = self._vcache[k] = list(self._compose(vctx, section, prefix, itype, name, fall))
+			return r
 
 	def _read_merged(self, vctx, section, variants, phase, itype, xtype):
 		exeref, adapter, *composition = self._load_descriptor(
@@ -272,11 +421,96 @@ class Context(object):
 		"""
 		# Load the product indicies.
 		"""
+		if self._loaded:
+			return self
+
 		self.projects.connect(self.route)
 		self.projects.load()
 		self.projects.configure()
+		self._loaded = True
 		return self
 
+	def identity(self) -> str:
+		"""
+		# Digest of the paths, sizes, and modification times of the files
+		# in the context directory. Used to validate &restore.
+		"""
+		if self._identity is not None:
+			return self._identity
+
+		h = hashlib.blake2b(digest_size=32)
+		root = str(self.route)
+		h.update(root.encode('utf-8'))
+
+		for path, dirs, names in os.walk(root):
+			dirs.sort()
+			for x in sorted(names):
+				try:
+					st = os.stat(os.path.join(path, x))
+				except FileNotFoundError:
+					continue
+
+				rpath = os.path.relpath(os.path.join(path, x), root)
+				h.update(f"{rpath}\x00{st.st_mtime_ns}\x00{st.st_size}\x00".encode('utf-8'))
+
+		self._identity = h.hexdigest()
+		return self._identity
+
+	def _counts(self):
+		# Insertions as evictions may leave the size unchanged.
+		return (self._vcache.insertions, len(self._scache))
+
+	def restore(self, route:files.Path) -> bool:
+		"""
+		# Restore the factor semantics, loaded vectors, and system commands
+		# written by &store. Returns &False and changes nothing if the
+		# snapshot is absent or the context directory has changed.
+
+		# When successful, neither &load nor &configure need to be performed;
+		# the project indicies are loaded on demand should a vector be missing.
+		"""
+		try:
+			state = pickle.loads(route.fs_load())
+		except (FileNotFoundError, pickle.UnpicklingError, EOFError):
+			return False
+		except Exception:
+			# Classes changed or otherwise unusable.
+			return False
+
+		if state.get('identity') != self.identity():
+			return False
+
+		self._idefault = state['semantics']
+		self._vcache.update(state['vectors'])
+		self._scache.update(state['systems'])
+		self._restored = self._counts()
+		return True
+
+	def store(self, route:files.Path) -> bool:
+		"""
+		# Write the factor semantics, loaded vectors, and system commands to &route
+		# for use by &restore in subsequent processes.
+		"""
+		if self._restored == self._counts():
+			# Nothing was added since &restore.
+			return True
+
+		state = {
+			'identity': self.identity(),
+			'semantics': self._idefault,
+			'vectors': self._vcache,
+			'systems': self._scache,
+		}
+
+		try:
+			data = pickle.dumps(state, protocol=pickle.HIGHEST_PROTOCOL)
+		except Exception:
+			return False
+
+		route.fs_alloc().fs_store(data)
+		self._restored = self._counts()
+		return True
+
 	def configure(self, context=(lsf.types.factor@'vectors')):
 		"""
 		# Load the default factor semantics.
@@ -286,6 +520,7 @@ class Context(object):
 
 	def _read_cell(self, factor):
 		# Load vector.
+		self.load()
 		product, project, fp = self.projects.split(factor)
 		for (name, ft), fd in project.select(fp.container):
 			if name == fp:
@@ -296,12 +531,50 @@ class Context(object):
 	def _load_vector(self, factor):
 		# Load vector.
 		typ, src = self._read_cell(factor)
-		return vf.parse(src.fs_load().decode('utf-8'))
+		if self.compiled is None:
+			return vf.parse(src.fs_load().decode('utf-8'))
+		else:
+			return self._load_compiled(src)
+
+	def _load_compiled(self, src):
+		# Load the parsed vector from &compiled if the source's
+		# modification time and size are consistent with the record.
+		st = src.fs_status().system
+		stamp = (st.st_mtime_ns, st.st_size)
+		name = hashlib.blake2b(str(src).encode('utf-8'), digest_size=16).hexdigest()
+		cpath = self.compiled / name
+
+		try:
+			cstamp, v = pickle.loads(cpath.fs_load())
+			if cstamp == stamp:
+				return v
+		except Exception:
+			# Absent, truncated, or incompatible.
+			pass
+
+		v = vf.parse(src.fs_load().decode('utf-8'))
+		try:
+			data = pickle.dumps((stamp, v), protocol=pickle.HIGHEST_PROTOCOL)
+			cpath.fs_alloc()
+
+			# Concurrent processes may be writing the same record.
+			tmp = str(cpath) + '.' + str(os.getpid())
+			with open(tmp, 'wb') as f:
+				f.write(data)
+			os.replace(tmp, str(cpath))
+		except Exception:
+			pass
+
+		return v
 
 	def _load_system(self, factor):
 		# Load system command.
+		if factor in self._scache:
+			return self._scache[factor]
+
 		typ, src = self._read_cell(factor)
-		return execution.parse_sx_plan(src.fs_load().decode('utf-8'))
+		sx = self._scache[factor] = execution.parse_sx_plan(src.fs_load().decode('utf-8'))
+		return sx
 
 	def _iq(self, name):
 		# Vector Reference Query method used during initialization.
@@ -316,10 +589,11 @@ class Context(object):
 
 	def _v(self, factor):
 		# Cached load vector.
-		if factor not in self._vcache:
-			self._vcache[factor] = self._load_vector(factor)
-
-		return self._vcache[factor]
+		try:
+			return self._vcache[factor]
+		except KeyError:
+			v = self._vcache[factor] = self._load_vector(factor)
+			return v
 
 	def _map_factor_semantics(self,
 			context:lsf.types.FactorPath,
@@ -0,0 +1,272 @@
+"""
+# Filesystem change notifications for resident constructions.
+
+# &watcher selects the mechanism available on the host: inotify on Linux,
+# kqueue on the BSDs and Darwin, and a polling fallback everywhere else.
+# All implementations report the paths of the watched files that changed.
+"""
+import os
+import sys
+import time
+import errno
+import select
+import struct
+import threading
+import typing
+
+class Polling(object):
+	"""
+	# Change detection by periodically comparing the status of the files.
+	"""
+
+	def __init__(self, paths:typing.Iterable[str], interval=0.25):
+		self.interval = interval
+		self.paths = set(paths)
+		self.states = {x: self._state(x) for x in self.paths}
+
+	@staticmethod
+	def _state(path):
+		try:
+			st = os.stat(path)
+		except OSError:
+			return None
+		return (st.st_mtime_ns, st.st_size, st.st_ino)
+
+	def update(self, paths:typing.Iterable[str]):
+		"""
+		# Watch the &paths that are not already being watched.
+		"""
+		added = set(paths) - self.paths
+		for x in added:
+			self.states[x] = self._state(x)
+		# Replaced rather than modified as &scan may be iterating.
+		self.paths = self.paths | added
+
+	def scan(self) -> typing.Set[str]:
+		changed = set()
+		for x in self.paths:
+			state = self._state(x)
+			if state != self.states[x]:
+				self.states[x] = state
+				changed.add(x)
+		return changed
+
+	def wait(self, timeout=None) -> typing.Set[str]:
+		"""
+		# Wait for changes to the watched files; returns an empty set on timeout.
+		"""
+		limit = None if timeout is None else time.monotonic() + timeout
+		while True:
+			changed = self.scan()
+			if changed or (limit is not None and time.monotonic() >= limit):
+				return changed
+			time.sleep(self.interval)
+
+	def close(self):
+		pass
+
+class Inotify(object):
+	"""
+	# Change detection using inotify(7) through &ctypes.
+
+	# The directories of the files are watched so that files replaced by
+	# editors continue to be observed.
+	"""
+	IN_MODIFY = 0x2
+	IN_ATTRIB = 0x4
+	IN_CLOSE_WRITE = 0x8
+	IN_MOVED_TO = 0x80
+	IN_CREATE = 0x100
+	IN_DELETE = 0x200
+	mask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB
+
+	_event = struct.Struct('iIII')
+
+	def __init__(self, paths:typing.Iterable[str]):
+		import ctypes
+		self._libc = libc = ctypes.CDLL(None, use_errno=True)
+
+		self.paths = set(paths)
+		self.fd = libc.inotify_init1(os.O_CLOEXEC)
+		if self.fd < 0:
+			e = ctypes.get_errno()
+			raise OSError(e, os.strerror(e))
+
+		self.directories = {}
+		self._watch({os.path.dirname(x) for x in self.paths})
+
+	def _watch(self, directories):
+		for d in directories:
+			wd = self._libc.inotify_add_watch(self.fd, d.encode('utf-8'), self.mask)
+			if wd >= 0:
+				self.directories[wd] = d
+
+	def update(self, paths:typing.Iterable[str]):
+		"""
+		# Watch the &paths that are not already being watched.
+		"""
+		added = set(paths) - self.paths
+		self.paths = self.paths | added
+		watched = set(self.directories.values())
+		self._watch({os.path.dirname(x) for x in added} - watched)
+
+	def read(self) -> typing.Set[str]:
+		data = os.read(self.fd, 64 * 1024)
+		changed = set()
+		i = 0
+		size = self._event.size
+		while i + size <= len(data):
+			wd, mask, cookie, length = self._event.unpack_from(data, i)
+			name = data[i+size:i+size+length].rstrip(b'\0').decode('utf-8', 'surrogateescape')
+			i += size + length
+
+			d = self.directories.get(wd)
+			if d is not None and name:
+				path = os.path.join(d, name)
+				if path in self.paths:
+					changed.add(path)
+		return changed
+
+	def wait(self, timeout=None) -> typing.Set[str]:
+		limit = None if timeout is None else time.monotonic() + timeout
+		while True:
+			remaining = None if limit is None else max(0, limit - time.monotonic())
+			r, w, x = select.select([self.fd], [], [], remaining)
+			if not r:
+				return set()
+
+			changed = self.read()
+			if changed:
+				return changed
+
+	def close(self):
+		os.close(self.fd)
+
+class Kqueue(object):
+	"""
+	# Change detection using kqueue(2) vnode filters.
+
+	# Files are reopened after they are deleted or renamed so that files
+	# replaced by editors continue to be observed.
+	"""
+
+	def __init__(self, paths:typing.Iterable[str]):
+		self.kq = select.kqueue()
+		self.paths = set(paths)
+		self.files = {} # descriptor -> path
+		self.flags = getattr(os, 'O_EVTONLY', os.O_RDONLY) | getattr(os, 'O_CLOEXEC', 0)
+		self.absent = set()
+		self.lock = threading.Lock()
+
+		for x in self.paths:
+			self._open(x)
+
+	def update(self, paths:typing.Iterable[str]):
+		"""
+		# Watch the &paths that are not already being watched.
+		"""
+		with self.lock:
+			for x in set(paths) - self.paths:
+				self.paths.add(x)
+				self._open(x)
+
+	def _open(self, path):
+		try:
+			fd = os.open(path, self.flags)
+		except OSError:
+			self.absent.add(path)
+			return
+
+		self.absent.discard(path)
+		self.files[fd] = path
+		ev = select.kevent(fd,
+			filter=select.KQ_FILTER_VNODE,
+			flags=select.KQ_EV_ADD | select.KQ_EV_CLEAR,
+			fflags=(
+				select.KQ_NOTE_WRITE | select.KQ_NOTE_EXTEND |
+				select.KQ_NOTE_DELETE | select.KQ_NOTE_RENAME |
+				select.KQ_NOTE_ATTRIB
+			),
+		)
+		self.kq.control([ev], 0, 0)
+
+	def wait(self, timeout=None) -> typing.Set[str]:
+		limit = None if timeout is None else time.monotonic() + timeout
+		while True:
+			changed = set()
+
+			# Replaced files are reopened when they reappear.
+			with self.lock:
+				for x in list(self.absent):
+					if os.path.exists(x):
+						self._open(x)
+						changed.add(x)
+
+			if not changed:
+				# Bounded so that absent files are periodically checked.
+				bound = 1.0 if limit is None else max(0, min(1.0, limit - time.monotonic()))
+				for ev in self.kq.control(None, 64, bound):
+					path = self.files.get(ev.ident)
+					if path is None:
+						continue
+
+					changed.add(path)
+					if ev.fflags & (select.KQ_NOTE_DELETE | select.KQ_NOTE_RENAME):
+						with self.lock:
+							del self.files[ev.ident]
+							os.close(ev.ident)
+							self._open(path)
+
+			if changed or (limit is not None and time.monotonic() >= limit):
+				return changed
+
+	def close(self):
+		for fd in self.files:
+			os.close(fd)
+		self.files.clear()
+		self.kq.close()
+
+def watcher(paths:typing.Iterable[str]):
+	"""
+	# Construct the watcher appropriate for the host.
+	"""
+	paths = list(paths)
+
+	if sys.platform.startswith('linux'):
+		try:
+			return Inotify(paths)
+		except (OSError, AttributeError):
+			pass
+	elif hasattr(select, 'kqueue'):
+		try:
+			return Kqueue(paths)
+		except OSError:
+			pass
+
+	return Polling(paths)
+
+def monitor(w, deliver, delay=0.05) -> threading.Thread:
+	"""
+	# Start a thread waiting on the watcher &w and calling &deliver with
+	# the set of changed paths.
+
+	# Changes occurring within &delay of the first are delivered together.
+	"""
+	def loop():
+		while True:
+			try:
+				changed = w.wait()
+			except OSError as err:
+				if err.errno == errno.EBADF:
+					# Closed.
+					return
+				raise
+
+			time.sleep(delay)
+			changed.update(w.wait(0))
+			if changed:
+				deliver(changed)
+
+	t = threading.Thread(target=loop, daemon=True)
+	t.start()
+	return t
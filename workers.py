@@ -0,0 +1,218 @@
+"""
+# Persistent worker processes for translation commands.
+
+# Construction contexts may declare a (id)`[worker]` vector for a Translate adapter
+# listing the arguments that start the command in worker mode. Workers are started
+# once per command template and receive requests over their standard input as JSON
+# lines:
+
+# (syntax/json)`{"id": "w1", "arguments": [...], "stdin": path, "stdout": path, "stderr": path}`
+
+# Responses are written to standard output as JSON lines holding the request's
+# identifier and the exit status of the operation:
+
+# (syntax/json)`{"id": "w1", "status": 0}`
+
+# Diagnostics are written by the worker to the (id)`stderr` path of the request.
+"""
+import json
+import itertools
+import threading
+import subprocess
+import collections
+import typing
+
+# Exit status reported when a worker terminates before responding.
+lost = 255
+
+class Exit(typing.NamedTuple):
+	"""
+	# Exit event of a request; corresponds to the process exit delta of a subprocess.
+	"""
+	status: int
+
+class Request(object):
+	"""
+	# An operation to be performed by a worker.
+
+	# Stored in the invocation slot of the instructions prepared by
+	# &.cc.prepare so that &.cc.Construction.process_execute submits the
+	# request to a &Pool instead of spawning a process.
+
+	# [ Properties ]
+	# /template/
+		# The executable, worker mode argument vector, and environment settings
+		# identifying the workers that may perform the request.
+	# /arguments/
+		# The arguments of the operation.
+	"""
+	__slots__ = ('template', 'arguments')
+
+	def __init__(self, template, arguments):
+		self.template = template
+		self.arguments = arguments
+
+class Worker(object):
+	"""
+	# A worker process and the thread reading its responses.
+	"""
+
+	def __init__(self, template, environ, complete):
+		xpath, argv, settings = template
+		self.template = template
+		self.complete = complete
+		self.pending = {} # request identifier -> callback
+		self.lock = threading.Lock()
+
+		self.process = subprocess.Popen(
+			list(argv), executable=str(xpath),
+			env=environ,
+			stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+			stderr=subprocess.DEVNULL,
+		)
+		self.reader = threading.Thread(target=self._read, daemon=True)
+		self.reader.start()
+
+	def send(self, ident, request, stdin, stdout, stderr, callback):
+		message = {
+			'id': ident,
+			'arguments': list(request.arguments),
+			'stdin': str(stdin),
+			'stdout': str(stdout),
+			'stderr': str(stderr),
+		}
+
+		with self.lock:
+			self.pending[ident] = callback
+
+		try:
+			self.process.stdin.write(json.dumps(message).encode('utf-8') + b'\n')
+			self.process.stdin.flush()
+		except OSError:
+			# Reader will observe the termination.
+			pass
+
+	def _read(self):
+		for line in self.process.stdout:
+			try:
+				response = json.loads(line)
+				ident = response['id']
+				status = int(response['status'])
+			except (ValueError, KeyError, TypeError):
+				continue
+
+			with self.lock:
+				callback = self.pending.pop(ident, None)
+			if callback is not None:
+				self.complete(self, callback, ident, Exit(status))
+
+		# Terminated; fail any outstanding requests.
+		with self.lock:
+			callbacks = list(self.pending.items())
+			self.pending.clear()
+		for ident, callback in callbacks:
+			self.complete(self, callback, ident, Exit(lost))
+
+	def terminate(self):
+		try:
+			self.process.stdin.close()
+		except OSError:
+			pass
+
+class Pool(object):
+	"""
+	# The workers of a build organized by command template.
+
+	# Workers perform one request at a time; a new worker is started when all
+	# of the template's workers are busy. The number of concurrent requests is
+	# bounded by the process slots of the &.cc.Processors instance submitting them.
+
+	# [ Parameters ]
+	# /environment/
+		# Callable producing the environment of a worker from the template's settings.
+	# /wake/
+		# Callable given &deliver when completions are waiting. Used to schedule
+		# the delivery on the thread running the build; a single delivery is
+		# scheduled at a time. When &None, completions are delivered by the
+		# worker's thread.
+	"""
+
+	def __init__(self, environment, wake=None):
+		self.environment = environment
+		self.idle = collections.defaultdict(list) # template -> [Worker]
+		self.workers = []
+		self.identifiers = itertools.count(1)
+		self.lock = threading.Lock()
+
+		# Completions read by the worker threads and not yet delivered.
+		self.wake = wake
+		self.completions = collections.deque()
+		self.scheduled = False
+
+	def _complete(self, worker, callback, ident, exit):
+		# Called from the worker's thread.
+		with self.lock:
+			self.completions.append((worker, callback, ident, exit))
+			if self.scheduled:
+				return
+			self.scheduled = self.wake is not None
+
+		if self.wake is None:
+			self.deliver()
+		else:
+			self.wake(self.deliver)
+
+	def deliver(self):
+		"""
+		# Return the workers of the completed requests to the idle set and
+		# invoke the callbacks of the requests.
+
+		# Performed by the task given to &wake, or by the worker's thread
+		# when the pool was created without one.
+		"""
+		with self.lock:
+			self.scheduled = False
+			completed = list(self.completions)
+			self.completions.clear()
+
+		for worker, callback, ident, exit in completed:
+			if exit.status != lost and worker.process.poll() is None:
+				# Available before the exit is processed.
+				with self.lock:
+					self.idle[worker.template].append(worker)
+			callback(ident, exit)
+
+	def submit(self, request:Request, stdin, stdout, stderr, callback) -> str:
+		"""
+		# Send the &request to an idle worker of its template.
+
+		# &callback is invoked by &deliver with the identifier and &Exit
+		# of the request. Returns the identifier of the request.
+		"""
+		ident = 'w' + str(next(self.identifiers))
+
+		with self.lock:
+			idle = self.idle[request.template]
+			worker = idle.pop() if idle else None
+
+		if worker is None:
+			settings = request.template[2]
+			worker = Worker(request.template, self.environment(settings), self._complete)
+			self.workers.append(worker)
+
+		worker.send(ident, request, stdin, stdout, stderr, callback)
+		return ident
+
+	def terminate(self):
+		"""
+		# Close the standard input of all workers allowing them to exit.
+		"""
+		for w in self.workers:
+			w.terminate()
+		for w in self.workers:
+			try:
+				w.process.wait(timeout=2)
+			except subprocess.TimeoutExpired:
+				w.process.kill()
+		del self.workers[:]
+		self.idle.clear()